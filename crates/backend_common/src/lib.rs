@@ -0,0 +1,151 @@
+//! Shared backend driver layer.
+//!
+//! Every hardware backend exposes `compile(graph, manifest)` which revalidates
+//! the graph before emitting. That is the right contract for a standalone
+//! call, but when one pass-processed graph fans out to several targets (the
+//! concurrent CLI compile, multi-chip deployments) it means N validations of
+//! the same IR. [`BackendDriver`] is the prevalidated entry point: the caller
+//! validates once, loads each manifest through the shared `nc_hal` store, and
+//! [`compile_many`] dispatches the jobs concurrently.
+
+use anyhow::Result;
+use std::sync::Arc;
+
+/// A backend that can compile an already-validated, pass-processed graph.
+///
+/// Implementations must not revalidate the graph or rerun the pass pipeline;
+/// `compile_many` (or an equivalent orchestrator) has done that once for all
+/// drivers. Manifests arrive preloaded from `nc_hal::manifest_for_path`,
+/// which validates on first load.
+pub trait BackendDriver: Sync {
+    /// Short backend name as used in telemetry labels (e.g. "loihi").
+    fn name(&self) -> &str;
+
+    /// Compile the graph for this backend and return an artifact descriptor.
+    fn compile_prevalidated(
+        &self,
+        graph: &nc_nir::Graph,
+        manifest: &nc_hal::TargetManifest,
+    ) -> Result<String>;
+}
+
+/// One fan-out job: a driver plus the manifest it compiles against.
+pub type Job<'a> = (&'a dyn BackendDriver, Arc<nc_hal::TargetManifest>);
+
+/// Validate `graph` once, then compile it for every job concurrently.
+///
+/// Results come back in job order; one backend failing does not abort the
+/// others. The outer `Result` is only an error when the graph itself is
+/// invalid, i.e. no backend ran at all.
+pub fn compile_many(graph: &nc_nir::Graph, jobs: &[Job<'_>]) -> Result<Vec<Result<String>>> {
+    graph.validate().map_err(|e| anyhow::anyhow!(e.to_string()))?;
+
+    #[cfg(feature = "telemetry")]
+    let app = nc_telemetry::profiling::env_appender();
+    #[cfg(feature = "telemetry")]
+    let _timer = app.as_ref().map(|a| {
+        let mut labels = std::collections::BTreeMap::new();
+        labels.insert("graph".to_string(), graph.name.clone());
+        labels.insert("jobs".to_string(), jobs.len().to_string());
+        a.start_timer("backend.compile_many_ms", labels)
+    });
+
+    // One thread per job: fan-out width is the number of targets (single
+    // digits), not the graph size, so no chunking is needed.
+    let results: Vec<Result<String>> = std::thread::scope(|s| {
+        let handles: Vec<_> = jobs
+            .iter()
+            .map(|(driver, manifest)| {
+                s.spawn(move || driver.compile_prevalidated(graph, manifest))
+            })
+            .collect();
+        handles.into_iter().map(|h| h.join().expect("backend driver panicked")).collect()
+    });
+
+    Ok(results)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    struct OkDriver {
+        tag: &'static str,
+        calls: AtomicUsize,
+    }
+    impl BackendDriver for OkDriver {
+        fn name(&self) -> &str {
+            self.tag
+        }
+        fn compile_prevalidated(
+            &self,
+            graph: &nc_nir::Graph,
+            manifest: &nc_hal::TargetManifest,
+        ) -> Result<String> {
+            self.calls.fetch_add(1, Ordering::SeqCst);
+            Ok(format!("compiled:{}:{}:{}", self.tag, manifest.name, graph.name))
+        }
+    }
+
+    struct FailDriver;
+    impl BackendDriver for FailDriver {
+        fn name(&self) -> &str {
+            "fail"
+        }
+        fn compile_prevalidated(
+            &self,
+            _graph: &nc_nir::Graph,
+            _manifest: &nc_hal::TargetManifest,
+        ) -> Result<String> {
+            anyhow::bail!("emitter exploded")
+        }
+    }
+
+    fn manifest() -> Arc<nc_hal::TargetManifest> {
+        Arc::new(
+            nc_hal::parse_target_manifest_str(
+                r#"
+                name = "t"
+                vendor = "V"
+                family = "F"
+                version = "1"
+            "#,
+            )
+            .unwrap(),
+        )
+    }
+
+    #[test]
+    fn compile_many_dispatches_every_job_and_keeps_order() {
+        let g = nc_nir::Graph::new("fanout");
+        let m = manifest();
+        let a = OkDriver { tag: "a", calls: AtomicUsize::new(0) };
+        let b = OkDriver { tag: "b", calls: AtomicUsize::new(0) };
+        let jobs: Vec<Job<'_>> = vec![(&a, m.clone()), (&FailDriver, m.clone()), (&b, m)];
+        let results = compile_many(&g, &jobs).unwrap();
+        assert_eq!(results.len(), 3);
+        assert_eq!(results[0].as_deref().unwrap(), "compiled:a:t:fanout");
+        assert!(results[1].as_ref().unwrap_err().to_string().contains("emitter exploded"));
+        assert_eq!(results[2].as_deref().unwrap(), "compiled:b:t:fanout");
+        assert_eq!(a.calls.load(Ordering::SeqCst), 1);
+        assert_eq!(b.calls.load(Ordering::SeqCst), 1);
+    }
+
+    #[test]
+    fn compile_many_validates_the_graph_once_up_front() {
+        let mut g = nc_nir::Graph::new("bad");
+        g.connections.push(nc_nir::Connection {
+            pre: "ghost".into(),
+            post: "ghost".into(),
+            weight: 1.0,
+            delay_ms: 0.0,
+            plasticity: None,
+            synapses: None,
+        });
+        let a = OkDriver { tag: "a", calls: AtomicUsize::new(0) };
+        let jobs: Vec<Job<'_>> = vec![(&a, manifest())];
+        assert!(compile_many(&g, &jobs).is_err());
+        assert_eq!(a.calls.load(Ordering::SeqCst), 0, "no driver runs on an invalid graph");
+    }
+}
@@ -3,14 +3,20 @@ use std::collections::BTreeMap;
 #[cfg(feature = "telemetry")]
 use nc_telemetry as telemetry;
 
+/// Validate then compile; the standalone entry point. Callers that have
+/// already validated the graph (e.g. `nc_backend_common::compile_many`)
+/// should use [`compile_prevalidated`] instead.
 pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
     graph.validate().map_err(|e| anyhow::anyhow!(e.to_string()))?;
     nc_hal::validate_manifest(manifest)?;
+    compile_prevalidated(graph, manifest)
+}
+
+/// Compile without revalidating; the graph and manifest must already be valid.
+pub fn compile_prevalidated(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
 
     #[cfg(feature = "telemetry")]
-    let app = std::env::var("NC_PROFILE_JSONL")
-        .ok()
-        .and_then(|p| telemetry::profiling::Appender::open(p).ok());
+    let app = telemetry::profiling::env_appender();
     #[cfg(feature = "telemetry")]
     let _timer = {
         if let Some(a) = app.as_ref() {
@@ -37,6 +43,15 @@ pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Resu
     Ok(artifact)
 }
 
+/// Driver for the shared backend fan-out (`nc_backend_common::compile_many`).
+pub struct Driver;
+impl nc_backend_common::BackendDriver for Driver {
+    fn name(&self) -> &str { "custom_asic" }
+    fn compile_prevalidated(&self, graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
+        compile_prevalidated(graph, manifest)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -1,15 +1,20 @@
 use anyhow::Result;
 
+/// Validate then compile; the standalone entry point. Callers that have
+/// already validated the graph (e.g. `nc_backend_common::compile_many`)
+/// should use [`compile_prevalidated`] instead.
 pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
-    // Basic validation
     graph.validate().map_err(|e| anyhow::anyhow!(e.to_string()))?;
     nc_hal::validate_manifest(manifest)?;
+    compile_prevalidated(graph, manifest)
+}
+
+/// Compile without revalidating; the graph and manifest must already be valid.
+pub fn compile_prevalidated(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
 
     // Optional telemetry profiling
     #[cfg(feature = "telemetry")]
-    let app = std::env::var("NC_PROFILE_JSONL")
-        .ok()
-        .and_then(|p| nc_telemetry::profiling::Appender::open(p).ok());
+    let app = nc_telemetry::profiling::env_appender();
     #[cfg(feature = "telemetry")]
     let _timer = {
         if let Some(a) = app.as_ref() {
@@ -34,6 +39,15 @@ pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Resu
     Ok(artifact)
 }
 
+/// Driver for the shared backend fan-out (`nc_backend_common::compile_many`).
+pub struct Driver;
+impl nc_backend_common::BackendDriver for Driver {
+    fn name(&self) -> &str { "loihi" }
+    fn compile_prevalidated(&self, graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
+        compile_prevalidated(graph, manifest)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -10,11 +10,13 @@ use serde_json::json;
 struct RvLowerPass;
 impl Pass for RvLowerPass {
     fn name(&self) -> &str { "rv-lower" }
+    fn mutation(&self) -> nc_nir::Mutation { nc_nir::Mutation::AttributesOnly }
     fn run(&self, g: nc_nir::Graph) -> Result<nc_nir::Graph> { Ok(g) }
 }
 struct RvLayoutPass;
 impl Pass for RvLayoutPass {
     fn name(&self) -> &str { "rv-layout" }
+    fn mutation(&self) -> nc_nir::Mutation { nc_nir::Mutation::AttributesOnly }
     fn run(&self, mut g: nc_nir::Graph) -> Result<nc_nir::Graph> {
         let caps = g.attributes.get("caps_riscv");
         let align = caps.and_then(|v| v.get("align_bytes")).and_then(|x| x.as_u64()).unwrap_or(16);
@@ -28,24 +30,94 @@ impl Pass for RvLayoutPass {
             "quant_bits_default": qbits
         });
         g.attributes.insert("rv_layout".to_string(), meta);
+        g.meta.rv_layout = Some(nc_nir::RvLayout {
+            align_bytes: align,
+            vector_available: vec_ok,
+            vector_bytes: vec_bytes,
+            quant_bits_default: qbits,
+        });
         Ok(g)
     }
 }
 struct RvSchedulePass;
+
+/// Default worker-thread cap when no partition attribute constrains the schedule.
+const RV_SCHEDULE_DEFAULT_THREADS: usize = 4;
+
 impl Pass for RvSchedulePass {
     fn name(&self) -> &str { "rv-schedule" }
+    fn mutation(&self) -> nc_nir::Mutation { nc_nir::Mutation::AttributesOnly }
     fn run(&self, mut g: nc_nir::Graph) -> Result<nc_nir::Graph> {
-        let vec_ok = g.attributes
-            .get("rv_layout")
-            .and_then(|v| v.get("vector_available"))
-            .and_then(|x| x.as_bool())
+        // Typed side-table first; the JSON attribute covers graphs that came
+        // back from disk, where `Graph::meta` is not serialized.
+        let vec_ok = g.meta.rv_layout.as_ref().map(|l| l.vector_available)
+            .or_else(|| g.attributes
+                .get("rv_layout")
+                .and_then(|v| v.get("vector_available"))
+                .and_then(|x| x.as_bool()))
             .unwrap_or(false);
         let fused = if vec_ok { vec!["op_fuse_vadd_vmul"] } else { vec!["op_fuse_scalar"] };
+
+        // Per-population thread assignment. Prefer the partition output
+        // (nc_passes::PartitionPass) when present; otherwise balance populations
+        // across a small worker pool by size (longest-processing-time greedy).
+        let mut threads: usize = 1;
+        let mut assignment: Vec<(String, usize)> = Vec::new();
+        if let Some(pa) = &g.meta.partition {
+            for (pop, part) in &pa.assignment {
+                assignment.push((pop.clone(), *part as usize));
+            }
+            if !assignment.is_empty() {
+                threads = pa.parts.max(1) as usize;
+            }
+        } else if let Some(assign) = g.attributes
+            .get("partition")
+            .and_then(|v| v.get("assignment"))
+            .and_then(|v| v.as_array())
+        {
+            let mut max_part = 0usize;
+            for a in assign {
+                if let (Some(pop), Some(part)) = (
+                    a.get("population").and_then(|x| x.as_str()),
+                    a.get("part").and_then(|x| x.as_u64()),
+                ) {
+                    assignment.push((pop.to_string(), part as usize));
+                    max_part = max_part.max(part as usize);
+                }
+            }
+            if !assignment.is_empty() {
+                threads = max_part + 1;
+            }
+        }
+        if assignment.is_empty() && !g.populations.is_empty() {
+            threads = g.populations.len().min(RV_SCHEDULE_DEFAULT_THREADS);
+            let mut load = vec![0usize; threads];
+            let mut pops: Vec<(String, usize)> = g.populations.iter()
+                .map(|p| (p.name.clone(), p.size as usize))
+                .collect();
+            pops.sort_by_key(|(_, s)| std::cmp::Reverse(*s));
+            for (name, sz) in pops {
+                let idx = load.iter().enumerate().min_by_key(|&(_, &v)| v).map(|(i, _)| i).unwrap_or(0);
+                load[idx] += sz;
+                assignment.push((name, idx));
+            }
+        }
+
+        let assignment_json: Vec<serde_json::Value> = assignment
+            .iter()
+            .map(|(pop, t)| json!({ "population": pop, "thread": t }))
+            .collect();
         let meta = json!({
-            "threads": 1,
-            "fused_stages": fused
+            "threads": threads as u64,
+            "fused_stages": fused,
+            "assignment": assignment_json
         });
         g.attributes.insert("rv_schedule".to_string(), meta);
+        g.meta.rv_schedule = Some(nc_nir::RvSchedule {
+            threads: threads as u64,
+            fused_stages: fused.iter().map(|s| s.to_string()).collect(),
+            assignment: assignment.iter().map(|(pop, t)| (pop.clone(), *t as u64)).collect(),
+        });
         Ok(g)
     }
 }
@@ -53,19 +125,26 @@ impl Pass for RvSchedulePass {
 struct RvVectorizePass;
 impl Pass for RvVectorizePass {
     fn name(&self) -> &str { "rv-vectorize" }
+    fn mutation(&self) -> nc_nir::Mutation { nc_nir::Mutation::AttributesOnly }
     fn run(&self, mut g: nc_nir::Graph) -> Result<nc_nir::Graph> {
-        let vec_ok = g.attributes
-            .get("rv_layout")
-            .and_then(|v| v.get("vector_available"))
-            .and_then(|x| x.as_bool())
-            .unwrap_or(false);
-        let vlen = g.attributes
-            .get("rv_layout")
-            .and_then(|v| v.get("vector_bytes"))
-            .and_then(|x| x.as_u64())
-            .unwrap_or(0);
+        let (vec_ok, vlen) = match &g.meta.rv_layout {
+            Some(l) => (l.vector_available, l.vector_bytes),
+            None => (
+                g.attributes
+                    .get("rv_layout")
+                    .and_then(|v| v.get("vector_available"))
+                    .and_then(|x| x.as_bool())
+                    .unwrap_or(false),
+                g.attributes
+                    .get("rv_layout")
+                    .and_then(|v| v.get("vector_bytes"))
+                    .and_then(|x| x.as_u64())
+                    .unwrap_or(0),
+            ),
+        };
         let meta = json!({ "enabled": vec_ok, "vlen_bytes": vlen });
         g.attributes.insert("rv_vectorize".to_string(), meta);
+        g.meta.rv_vectorize = Some(nc_nir::RvVectorize { enabled: vec_ok, vlen_bytes: vlen });
         Ok(g)
     }
 }
@@ -73,6 +152,7 @@ impl Pass for RvVectorizePass {
 struct RvBaremetalTuningPass;
 impl Pass for RvBaremetalTuningPass {
     fn name(&self) -> &str { "rv-baremetal-tuning" }
+    fn mutation(&self) -> nc_nir::Mutation { nc_nir::Mutation::AttributesOnly }
     fn run(&self, mut g: nc_nir::Graph) -> Result<nc_nir::Graph> {
         let caps = g.attributes.get("caps_riscv");
         let has_c = caps.and_then(|v| v.get("has_c")).and_then(|x| x.as_bool()).unwrap_or(false);
@@ -88,6 +168,7 @@ impl Pass for RvBaremetalTuningPass {
 struct RvControlPlanePass;
 impl Pass for RvControlPlanePass {
     fn name(&self) -> &str { "rv-control-plane-driver" }
+    fn mutation(&self) -> nc_nir::Mutation { nc_nir::Mutation::AttributesOnly }
     fn run(&self, mut g: nc_nir::Graph) -> Result<nc_nir::Graph> {
         let caps = g.attributes.get("caps_riscv");
         let mmio = caps.and_then(|v| v.get("mmio_supported")).and_then(|x| x.as_bool()).unwrap_or(false);
@@ -113,12 +194,17 @@ pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Resu
     // Validate input IR and target manifest
     graph.validate().map_err(|e| anyhow::anyhow!(e.to_string()))?;
     nc_hal::validate_manifest(manifest)?;
+    compile_prevalidated(graph, manifest)
+}
 
+/// Compile without revalidating; the graph and manifest must already be valid.
+/// Fan-out callers (`nc_backend_common::compile_many`) land here via [`Driver`].
+/// The RV-specific lowering pipeline still runs — it is target lowering, not
+/// the shared validation the caller already performed.
+pub fn compile_prevalidated(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
     // Optional telemetry profiling
     #[cfg(feature = "telemetry")]
-    let app = std::env::var("NC_PROFILE_JSONL")
-        .ok()
-        .and_then(|p| nc_telemetry::profiling::Appender::open(p).ok());
+    let app = nc_telemetry::profiling::env_appender();
 
     #[cfg(feature = "telemetry")]
     let _timer = {
@@ -135,6 +221,28 @@ pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Resu
         let _ = fs::create_dir_all(&out_dir);
     }
 
+    // Content-addressed cache: if graph, manifest, and toolchain are unchanged
+    // since the last compile into this out_dir, return the existing artifact
+    // without re-running the pipeline or the cross compiler. Opt out with
+    // NC_RISCV_CACHE=0; QEMU runs are side-effecting, so they bypass the cache.
+    let cache_enabled = std::env::var("NC_RISCV_CACHE").map(|v| v != "0").unwrap_or(true)
+        && std::env::var("NC_RISCV_QEMU_RUN").map(|v| v != "1").unwrap_or(true);
+    let cache_key = compile_cache_key(graph, manifest);
+    let cache_key_path = out_dir.join("cache.key");
+    if cache_enabled {
+        if let Some(key) = cache_key.as_deref() {
+            let prev = fs::read_to_string(&cache_key_path).unwrap_or_default();
+            if prev.trim() == key && out_dir.join("README.txt").exists() {
+                #[cfg(feature = "telemetry")]
+                if let Some(a) = &app {
+                    let l = nc_telemetry::labels::backend(&graph.name, "riscv", Some(&manifest.name));
+                    let _ = a.counter("backend.cache_hits", 1.0, l);
+                }
+                return Ok(format!("artifact:{}", out_dir.to_string_lossy()));
+            }
+        }
+    }
+
     // Determine profile with backward-compatible fallback
     let profile = manifest.capabilities
         .as_ref()
@@ -162,9 +270,120 @@ pub fn compile(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Resu
         let _ = a.counter("graph.probes", graph.probes.len() as f64, l);
     }
 
+    // Record the cache key only after a fully successful compile.
+    if let Some(key) = cache_key.as_deref() {
+        let _ = fs::write(&cache_key_path, key);
+    }
+
     Ok(artifact)
 }
 
+/// 64-bit FNV-1a over a byte slice; stable across runs and platforms.
+fn fnv1a64(bytes: &[u8], mut hash: u64) -> u64 {
+    const PRIME: u64 = 0x0000_0100_0000_01b3;
+    for b in bytes {
+        hash ^= u64::from(*b);
+        hash = hash.wrapping_mul(PRIME);
+    }
+    hash
+}
+
+const FNV_OFFSET: u64 = 0xcbf2_9ce4_8422_2325;
+
+/// Process-wide toolchain registry. Each tool is resolved at most once per
+/// process by walking PATH directly — no `sh -lc` fork per probe — and both
+/// the resolved path and the `--version` line are cached. Batch compiles call
+/// into this from every build/run helper, so the probes must be one-shot.
+mod toolchain {
+    use std::collections::HashMap;
+    use std::path::Path;
+    use std::sync::{Mutex, OnceLock};
+
+    #[derive(Default)]
+    struct Registry {
+        paths: Mutex<HashMap<String, Option<String>>>,
+        versions: Mutex<HashMap<String, Option<String>>>,
+    }
+
+    static REGISTRY: OnceLock<Registry> = OnceLock::new();
+
+    fn registry() -> &'static Registry {
+        REGISTRY.get_or_init(Registry::default)
+    }
+
+    fn is_executable(p: &Path) -> bool {
+        #[cfg(unix)]
+        {
+            use std::os::unix::fs::PermissionsExt;
+            p.metadata().map(|m| m.is_file() && m.permissions().mode() & 0o111 != 0).unwrap_or(false)
+        }
+        #[cfg(not(unix))]
+        {
+            p.is_file()
+        }
+    }
+
+    fn probe(name: &str) -> Option<String> {
+        if name.contains('/') {
+            return is_executable(Path::new(name)).then(|| name.to_string());
+        }
+        let path = std::env::var_os("PATH")?;
+        for dir in std::env::split_paths(&path) {
+            let cand = dir.join(name);
+            if is_executable(&cand) {
+                return Some(cand.to_string_lossy().into_owned());
+            }
+        }
+        None
+    }
+
+    /// Resolve `name` to an invocable path, probing PATH once per process.
+    pub(crate) fn resolve(name: &str) -> Option<String> {
+        let mut cache = registry().paths.lock().expect("toolchain path cache");
+        cache.entry(name.to_string()).or_insert_with(|| probe(name)).clone()
+    }
+
+    /// First `--version` line of `name`, captured once per process.
+    pub(crate) fn version(name: &str) -> Option<String> {
+        let resolved = resolve(name)?;
+        let mut cache = registry().versions.lock().expect("toolchain version cache");
+        cache
+            .entry(name.to_string())
+            .or_insert_with(|| {
+                std::process::Command::new(&resolved)
+                    .arg("--version")
+                    .output()
+                    .ok()
+                    .filter(|o| o.status.success())
+                    .and_then(|o| {
+                        String::from_utf8_lossy(&o.stdout).lines().next().map(str::to_string)
+                    })
+            })
+            .clone()
+    }
+}
+
+/// First line of the cross toolchain's --version output, or "none".
+/// Part of the cache key so a toolchain upgrade invalidates old artifacts.
+fn toolchain_version_line() -> String {
+    for tool in ["riscv64-linux-gnu-gcc", "clang"] {
+        if let Some(line) = toolchain::version(tool) {
+            return line;
+        }
+    }
+    "none".to_string()
+}
+
+/// Cache key over canonical graph bytes, the parsed manifest, and the
+/// toolchain version. None if the graph cannot be serialized.
+fn compile_cache_key(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Option<String> {
+    let graph_json = graph.to_json_string().ok()?;
+    let mut h = fnv1a64(graph_json.as_bytes(), FNV_OFFSET);
+    h = fnv1a64(format!("{manifest:?}").as_bytes(), h);
+    h = fnv1a64(toolchain_version_line().as_bytes(), h);
+    Some(format!("{h:016x}"))
+}
+
 /// Run the RISC-V pass pipeline appropriate to `profile`, dump JSON, and collect README metadata.
 /// Best-effort: records warnings instead of failing the compile.
 fn run_pipeline_and_collect_meta(
@@ -176,109 +395,106 @@ fn run_pipeline_and_collect_meta(
 ) -> Vec<String> {
     let mut meta_lines: Vec<String> = Vec::new();
 
-    if let Ok(s) = graph.to_json_string() {
-        match nc_nir::Graph::from_json_str(&s) {
-            Ok(mut g_owned) => {
-                // Attach RISC-V caps summary for passes to consume
-                let caps = manifest.capabilities.as_ref();
-                let vector_available = caps.and_then(|c| c.has_vector).unwrap_or(false);
-                let align_bytes = caps.and_then(|c| c.cacheline_bytes).unwrap_or(16);
-                let quant_bits_default = caps
-                    .and_then(|c| c.weight_precisions.as_ref()
-                    .and_then(|v| v.iter().min().copied()))
-                    .unwrap_or(8);
-                let has_c = caps.and_then(|c| c.has_c).unwrap_or(false);
-                let mmio_supported = caps.and_then(|c| c.mmio_supported).unwrap_or(false);
-                let mmio_width_bits = caps.and_then(|c| c.mmio_width_bits);
-                let dma_supported = caps.and_then(|c| c.dma_supported).unwrap_or(false);
-                let dma_alignment = caps.and_then(|c| c.dma_alignment);
-
-                let caps_json = serde_json::json!({
-                    "vector_available": vector_available,
-                    "align_bytes": align_bytes,
-                    "quant_bits_default": quant_bits_default,
-                    "has_c": has_c,
-                    "mmio_supported": mmio_supported,
-                    "mmio_width_bits": mmio_width_bits,
-                    "dma_supported": dma_supported,
-                    "dma_alignment": dma_alignment
-                });
-                g_owned.attributes.insert("caps_riscv".to_string(), caps_json);
-
-                let mut pm = PassManager::new();
-                pm.add_pass(nc_passes::ValidatePass);
-                pm.add_pass(RvLowerPass);
-                pm.add_pass(RvLayoutPass);
-                match profile {
-                    "linux_user" => {
-                        pm.add_pass(RvSchedulePass);
-                        pm.add_pass(RvVectorizePass);
-                    }
-                    "bare_metal" => {
-                        pm.add_pass(RvBaremetalTuningPass);
-                    }
-                    "control_plane" => {
-                        pm.add_pass(RvControlPlanePass);
-                    }
-                    _ => {
-                        pm.add_pass(RvSchedulePass);
-                    }
+    // Graph is Clone; take an owned in-memory copy for the PassManager rather
+    // than round-tripping through JSON (serialization happens only for dumps).
+    let mut g_owned = graph.clone();
+    // Attach RISC-V caps summary for passes to consume
+    let caps = manifest.capabilities.as_ref();
+    let vector_available = caps.and_then(|c| c.has_vector).unwrap_or(false);
+    let align_bytes = caps.and_then(|c| c.cacheline_bytes).unwrap_or(16);
+    let quant_bits_default = caps
+        .and_then(|c| c.weight_precisions.as_ref()
+        .and_then(|v| v.iter().min().copied()))
+        .unwrap_or(8);
+    let has_c = caps.and_then(|c| c.has_c).unwrap_or(false);
+    let mmio_supported = caps.and_then(|c| c.mmio_supported).unwrap_or(false);
+    let mmio_width_bits = caps.and_then(|c| c.mmio_width_bits);
+    let dma_supported = caps.and_then(|c| c.dma_supported).unwrap_or(false);
+    let dma_alignment = caps.and_then(|c| c.dma_alignment);
+
+    let caps_json = serde_json::json!({
+        "vector_available": vector_available,
+        "align_bytes": align_bytes,
+        "quant_bits_default": quant_bits_default,
+        "has_c": has_c,
+        "mmio_supported": mmio_supported,
+        "mmio_width_bits": mmio_width_bits,
+        "dma_supported": dma_supported,
+        "dma_alignment": dma_alignment
+    });
+    g_owned.attributes.insert("caps_riscv".to_string(), caps_json);
+
+    let mut pm = PassManager::new();
+    pm.add_pass(nc_passes::ValidatePass);
+    pm.add_pass(RvLowerPass);
+    pm.add_pass(RvLayoutPass);
+    match profile {
+        "linux_user" => {
+            pm.add_pass(RvSchedulePass);
+            pm.add_pass(RvVectorizePass);
+        }
+        "bare_metal" => {
+            pm.add_pass(RvBaremetalTuningPass);
+        }
+        "control_plane" => {
+            pm.add_pass(RvControlPlanePass);
+        }
+        _ => {
+            pm.add_pass(RvSchedulePass);
+        }
+    }
+    let cfg = PipelineConfig {
+        dump_dir: Some(out_dir.join("passes")),
+        dump_formats: vec![DumpFormat::Json],
+        // Recompiles into the same out_dir (e.g. profile sweeps after only
+        // manifest knob changes) skip the unchanged validate/lower prefix.
+        cache: true,
+        ..Default::default()
+    };
+    match pm.run_with_config(g_owned, &cfg) {
+        Ok(g_after) => {
+            if let Some(v) = g_after.attributes.get("rv_layout") {
+                if let Some(al) = v.get("align_bytes").and_then(|x| x.as_u64()) {
+                    meta_lines.push(format!("align_bytes={al}"));
                 }
-                let cfg = PipelineConfig {
-                    dump_dir: Some(out_dir.join("passes")),
-                    dump_formats: vec![DumpFormat::Json],
-                    ..Default::default()
-                };
-                match pm.run_with_config(g_owned, &cfg) {
-                    Ok(g_after) => {
-                        if let Some(v) = g_after.attributes.get("rv_layout") {
-                            if let Some(al) = v.get("align_bytes").and_then(|x| x.as_u64()) {
-                                meta_lines.push(format!("align_bytes={al}"));
-                            }
-                            if let Some(q) = v.get("quant_bits_default").and_then(|x| x.as_u64()) {
-                                meta_lines.push(format!("quant_bits_default={q}"));
-                            }
-                            if let Some(vec_ok) = v.get("vector_available").and_then(|x| x.as_bool()) {
-                                meta_lines.push(format!("vector_available={vec_ok}"));
-                            }
-                        }
-                        if let Some(v) = g_after.attributes.get("rv_schedule") {
-                            if let Some(fs) = v.get("fused_stages").and_then(|x| x.as_array()) {
-                                let names: Vec<String> = fs.iter().filter_map(|e| e.as_str().map(|s| s.to_string())).collect();
-                                if !names.is_empty() {
-                                    meta_lines.push(format!("fused_stages={}", names.join("+")));
-                                }
-                            }
-                            if let Some(t) = v.get("threads").and_then(|x| x.as_u64()) {
-                                meta_lines.push(format!("threads={t}"));
-                            }
-                        }
-                        if let Some(v) = g_after.attributes.get("rv_bare_tuning") {
-                            if let Some(sz) = v.get("size_optimized").and_then(|x| x.as_bool()) {
-                                meta_lines.push(format!("size_optimized={sz}"));
-                            }
-                            if let Some(uc) = v.get("use_compressed").and_then(|x| x.as_bool()) {
-                                meta_lines.push(format!("use_compressed={uc}"));
-                            }
-                        }
-                        if let Some(v) = g_after.attributes.get("rv_ctrl_plane") {
-                            if let Some(mmio) = v.get("mmio_supported").and_then(|x| x.as_bool()) {
-                                meta_lines.push(format!("mmio_supported={mmio}"));
-                            }
-                            if let Some(d) = v.get("dma_supported").and_then(|x| x.as_bool()) {
-                                meta_lines.push(format!("dma_supported={d}"));
-                            }
-                        }
-                    }
-                    Err(e) => {
-                        warnings.push(format!("pass pipeline failed: {e}"));
+                if let Some(q) = v.get("quant_bits_default").and_then(|x| x.as_u64()) {
+                    meta_lines.push(format!("quant_bits_default={q}"));
+                }
+                if let Some(vec_ok) = v.get("vector_available").and_then(|x| x.as_bool()) {
+                    meta_lines.push(format!("vector_available={vec_ok}"));
+                }
+            }
+            if let Some(v) = g_after.attributes.get("rv_schedule") {
+                if let Some(fs) = v.get("fused_stages").and_then(|x| x.as_array()) {
+                    let names: Vec<String> = fs.iter().filter_map(|e| e.as_str().map(|s| s.to_string())).collect();
+                    if !names.is_empty() {
+                        meta_lines.push(format!("fused_stages={}", names.join("+")));
                     }
                 }
+                if let Some(t) = v.get("threads").and_then(|x| x.as_u64()) {
+                    meta_lines.push(format!("threads={t}"));
+                }
+            }
+            if let Some(v) = g_after.attributes.get("rv_bare_tuning") {
+                if let Some(sz) = v.get("size_optimized").and_then(|x| x.as_bool()) {
+                    meta_lines.push(format!("size_optimized={sz}"));
+                }
+                if let Some(uc) = v.get("use_compressed").and_then(|x| x.as_bool()) {
+                    meta_lines.push(format!("use_compressed={uc}"));
+                }
+            }
+            if let Some(v) = g_after.attributes.get("rv_ctrl_plane") {
+                if let Some(mmio) = v.get("mmio_supported").and_then(|x| x.as_bool()) {
+                    meta_lines.push(format!("mmio_supported={mmio}"));
+                }
+                if let Some(d) = v.get("dma_supported").and_then(|x| x.as_bool()) {
+                    meta_lines.push(format!("dma_supported={d}"));
+                }
             }
-            Err(e) => warnings.push(format!("graph roundtrip (json) failed: {e}")),
         }
-    } else {
-        warnings.push("graph serialization to JSON failed".into());
+        Err(e) => {
+            warnings.push(format!("pass pipeline failed: {e}"));
+        }
     }
 
     meta_lines
@@ -422,8 +638,20 @@ fn compile_control_plane(graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifes
     Ok(format!("artifact:{}", out_dir.to_string_lossy()))
 }
 
+/// Join per-element table entries into a C initializer list.
+fn join_table<T>(items: &[T], f: impl Fn(&T) -> String) -> String {
+    items.iter().map(f).collect::<Vec<_>>().join(", ")
+}
+
 /// Emit bare-metal templates: linker.ld, crt0.S, and main.c (polled UART at 0x10000000).
+/// The generated kernel is an event-driven stepping loop over the input graph:
+/// fixed-point per-population state arrays aligned per rv-layout, a statically
+/// sized spike ring buffer in the 4M RAM region, and per-stage rdcycle/rdinstret
+/// deltas labelled with the fused stage names from rv-schedule.
+#[allow(clippy::uninlined_format_args)]
 fn emit_bare_metal_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<()> {
+    use std::fmt::Write as _;
+
     if !out_dir.exists() {
         fs::create_dir_all(out_dir)?;
     }
@@ -431,6 +659,98 @@ fn emit_bare_metal_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &nc_
     let graph_name = &graph.name;
     let _target_name = &manifest.name;
 
+    // Alignment from rv-layout (typed side-table, in-graph attribute, or pass
+    // dump fallback, in that order).
+    let mut align_bytes: u64 = graph.meta.rv_layout.as_ref().map(|l| l.align_bytes)
+        .or_else(|| graph.attributes
+            .get("rv_layout")
+            .and_then(|v| v.get("align_bytes"))
+            .and_then(|x| x.as_u64()))
+        .unwrap_or(0);
+    // Fused stage names from rv-schedule; the update stage is instrumented under
+    // the first listed name, spike delivery under "spike_propagate".
+    let mut fused_stages: Vec<String> = graph.meta.rv_schedule.as_ref()
+        .map(|s| s.fused_stages.clone())
+        .or_else(|| graph.attributes
+            .get("rv_schedule")
+            .and_then(|v| v.get("fused_stages"))
+            .and_then(|a| a.as_array())
+            .map(|a| a.iter().filter_map(|s| s.as_str().map(str::to_string)).collect()))
+        .unwrap_or_default();
+    // Dumps are full graph snapshots, so the pass output lives under "attributes".
+    if align_bytes == 0 || fused_stages.is_empty() {
+        let passes_dir = out_dir.join("passes");
+        if let Ok(rd) = fs::read_dir(&passes_dir) {
+            for e in rd.flatten() {
+                let fname = e.file_name().to_string_lossy().to_string();
+                let want_layout = align_bytes == 0 && fname.contains("rv-layout");
+                let want_sched = fused_stages.is_empty() && fname.contains("rv-schedule");
+                if !want_layout && !want_sched {
+                    continue;
+                }
+                if let Ok(s) = fs::read_to_string(e.path()) {
+                    if let Ok(val) = serde_json::from_str::<serde_json::Value>(&s) {
+                        if want_layout {
+                            if let Some(al) = val
+                                .get("attributes")
+                                .and_then(|a| a.get("rv_layout"))
+                                .and_then(|v| v.get("align_bytes"))
+                                .and_then(|x| x.as_u64())
+                            {
+                                align_bytes = al;
+                            }
+                        }
+                        if want_sched {
+                            if let Some(fs_arr) = val
+                                .get("attributes")
+                                .and_then(|a| a.get("rv_schedule"))
+                                .and_then(|v| v.get("fused_stages"))
+                                .and_then(|a| a.as_array())
+                            {
+                                fused_stages = fs_arr
+                                    .iter()
+                                    .filter_map(|s| s.as_str().map(str::to_string))
+                                    .collect();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if align_bytes == 0 {
+        align_bytes = manifest
+            .capabilities
+            .as_ref()
+            .and_then(|c| c.cacheline_bytes)
+            .unwrap_or(16) as u64;
+    }
+    if fused_stages.is_empty() {
+        fused_stages.push("op_fuse_scalar".to_string());
+    }
+    let update_stage = fused_stages[0].clone();
+
+    // Populations drive codegen; an empty graph still gets a minimal self-driven
+    // population so the firmware remains buildable and produces metrics.
+    // Tuple: (original name, C identifier, size, model).
+    let pops: Vec<(String, String, u32, String)> = if graph.populations.is_empty() {
+        vec![("pop0".to_string(), "pop0".to_string(), 1024u32, "lif".to_string())]
+    } else {
+        graph.populations.iter()
+            .map(|p| (p.name.clone(), c_ident(&p.name), p.size.max(1), p.model.to_lowercase()))
+            .collect()
+    };
+    let pop_index = |name: &str| pops.iter().position(|(n, _, _, _)| n == name);
+    // Weights are Q10 fixed point: rv32imac has no FPU and we keep the kernel
+    // free of soft-float calls.
+    let conns: Vec<(usize, usize, i32)> = graph.connections.iter()
+        .filter_map(|c| Some((pop_index(&c.pre)?, pop_index(&c.post)?, (c.weight * 1024.0).round() as i32)))
+        .collect();
+    let total_neurons: u64 = pops.iter().map(|p| p.2 as u64).sum();
+    // Ring capacity: power of two, sized to a couple of full firings but bounded
+    // so the queue stays a small slice of the 4M RAM (spike_t is 4 bytes).
+    let evq_capacity = ((total_neurons * 2).clamp(256, 16384) as u32).next_power_of_two();
+
     // linker.ld
     let ld = r#"
 OUTPUT_ARCH(riscv)
@@ -492,10 +812,15 @@ _start:
     fs::write(out_dir.join("crt0.S"), crt0)?;
 
     // main.c (bare-metal, polled UART at 0x10000000, QEMU exit via 0x100000)
-    let c_src = format!(r#"
-#include <stdint.h>
+    let mut c = String::new();
+    let _ = write!(c, r#"#include <stdint.h>
 #include <stddef.h>
 
+/* RISC-V pass metadata (from pipeline/config):
+ *  - align_bytes={align}
+ *  - fused_stages={fused}
+ */
+
 #define UART0_BASE      0x10000000UL
 #define UART_THR        (UART0_BASE + 0x00)
 #define UART_LSR        (UART0_BASE + 0x05)
@@ -545,47 +870,184 @@ static inline void qemu_exit(uint32_t code) {{
     *fin = (code << 16) | QEMU_FINISHER_PASS;
 }}
 
+#define ALIGN_BYTES {align}u
+#define N_STEPS 100u
+#define SOURCE_PERIOD 10u /* source populations fire every SOURCE_PERIOD steps */
+
+/* LIF dynamics in Q10 fixed point (no FPU on rv32imac): decay 0.95, v_th 1.0 */
+#define LIF_Q        10
+#define LIF_DECAY_Q  973
+#define LIF_V_TH_Q   1024
+
+"#,
+        align = align_bytes,
+        fused = fused_stages.join(",")
+    );
+
+    // Per-population sizes
+    for (name, id, size, model) in &pops {
+        let _ = writeln!(
+            c,
+            "#define N_{up} {size}u /* population '{name}' model={model} */",
+            up = id.to_uppercase()
+        );
+    }
+    let _ = writeln!(c);
+    let _ = writeln!(c, "#define N_POPS {}u", pops.len());
+    let _ = writeln!(c, "#define N_CONNS {}u", conns.len());
+    let _ = writeln!(c);
+
+    // Static tables: sizes, source flags, connection triples (weights in Q10).
+    let _ = writeln!(c, "static const uint32_t pop_size[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| format!("N_{}", p.1.to_uppercase())));
+    let _ = writeln!(c, "static const uint8_t pop_is_source[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| if p.3 == "source" { "1".to_string() } else { "0".to_string() }));
+    if !conns.is_empty() {
+        let _ = writeln!(c, "static const uint32_t conn_pre[N_CONNS] = {{ {} }};",
+            conns.iter().map(|(p, _, _)| format!("{p}u")).collect::<Vec<_>>().join(", "));
+        let _ = writeln!(c, "static const uint32_t conn_post[N_CONNS] = {{ {} }};",
+            conns.iter().map(|(_, p, _)| format!("{p}u")).collect::<Vec<_>>().join(", "));
+        let _ = writeln!(c, "static const int32_t conn_w[N_CONNS] = {{ {} }}; /* Q10 */",
+            conns.iter().map(|(_, _, w)| w.to_string()).collect::<Vec<_>>().join(", "));
+        for (i, (pre, post, _)) in conns.iter().enumerate() {
+            let _ = writeln!(c, "/* conn #{i}: {} -> {} */", pops[*pre].0, pops[*post].0);
+        }
+    }
+    let _ = writeln!(c);
+
+    // Per-population state arrays: statically placed in the 4M RAM (.bss per
+    // linker.ld, zeroed by crt0) on rv-layout alignment boundaries.
+    for (_, id, _, _) in &pops {
+        let up = id.to_uppercase();
+        let _ = writeln!(c, "static int32_t v_{id}[N_{up}] __attribute__((aligned(ALIGN_BYTES)));");
+        let _ = writeln!(c, "static int32_t in_{id}[N_{up}] __attribute__((aligned(ALIGN_BYTES)));");
+    }
+    let _ = writeln!(c);
+    let _ = writeln!(c, "static int32_t* const v_m[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| format!("v_{}", p.1)));
+    let _ = writeln!(c, "static int32_t* const in_cur[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| format!("in_{}", p.1)));
+    let _ = writeln!(c);
+
+    let _ = write!(c, r#"/* Statically sized spike ring buffer in the 4M RAM region. Each fired neuron
+ * pushes one event; the propagation stage drains the ring. On overflow events
+ * are dropped and counted (population indices above 64K truncate to uint16). */
+typedef struct {{ uint16_t pop; uint16_t idx; }} spike_t;
+#define EVQ_CAPACITY {cap}u
+#define EVQ_MASK (EVQ_CAPACITY - 1u)
+static spike_t evq[EVQ_CAPACITY] __attribute__((aligned(ALIGN_BYTES)));
+static uint32_t evq_head, evq_tail, evq_dropped;
+
+static inline void evq_push(uint16_t pop, uint16_t idx) {{
+    uint32_t next = (evq_head + 1u) & EVQ_MASK;
+    if (next == evq_tail) {{ evq_dropped++; return; }}
+    evq[evq_head].pop = pop;
+    evq[evq_head].idx = idx;
+    evq_head = next;
+}}
+
+/* JSONL metric line over UART; `stage` label is optional. */
+static void print_metric(const char* graph, const char* metric, uint32_t value, const char* stage) {{
+    uart_puts("{{\"metric\":\""); uart_puts(metric);
+    uart_puts("\",\"value\":"); print_u32(value);
+    uart_puts(",\"labels\":{{\"graph\":\""); uart_puts(graph);
+    uart_puts("\",\"backend\":\"riscv\",\"isa\":\"rv32imac\",\"simulator\":\"qemu\"");
+    if (stage) {{ uart_puts(",\"stage\":\""); uart_puts(stage); uart_puts("\""); }}
+    uart_puts("}}}}\n");
+}}
+
 int main(void) {{
     const char* graph = "{graph_name}";
-    const char* backend = "riscv";
-    const char* isa = "rv32imac";
-    const char* simulator = "qemu";
 
-    volatile uint32_t acc = 0;
+    uint32_t update_cycles = 0, update_instret = 0;
+    uint32_t prop_cycles = 0, prop_instret = 0;
+    uint32_t events = 0;
+
     uint32_t c0 = rdcycle();
     uint32_t i0 = rdinstret();
 
-    for (uint32_t i = 0; i < 100000; ++i) {{ acc += i; }}
+    for (uint32_t step = 0; step < N_STEPS; ++step) {{
+        /* Stage '{update}': fused decay+integrate+threshold; fired neurons
+         * push spike events into the ring. */
+        uint32_t sc = rdcycle();
+        uint32_t si = rdinstret();
+        for (uint32_t p = 0; p < N_POPS; ++p) {{
+            uint32_t n = pop_size[p];
+            if (pop_is_source[p]) {{
+                if (step % SOURCE_PERIOD == 0u) {{
+                    for (uint32_t j = 0; j < n; ++j) evq_push((uint16_t)p, (uint16_t)j);
+                }}
+                continue;
+            }}
+            int32_t* v = v_m[p];
+            int32_t* in = in_cur[p];
+            for (uint32_t j = 0; j < n; ++j) {{
+                int32_t vq = (int32_t)(((int64_t)v[j] * LIF_DECAY_Q) >> LIF_Q) + in[j];
+                in[j] = 0;
+                if (vq >= LIF_V_TH_Q) {{
+                    vq = 0;
+                    evq_push((uint16_t)p, (uint16_t)j);
+                }}
+                v[j] = vq;
+            }}
+        }}
+        uint32_t mc = rdcycle();
+        uint32_t mi = rdinstret();
+        update_cycles += mc - sc;
+        update_instret += mi - si;
+
+        /* Stage 'spike_propagate': drain the ring, accumulating each event's
+         * Q10 weight into its post population. */
+#if N_CONNS > 0
+        while (evq_tail != evq_head) {{
+            spike_t s = evq[evq_tail];
+            evq_tail = (evq_tail + 1u) & EVQ_MASK;
+            events++;
+            for (uint32_t e = 0; e < N_CONNS; ++e) {{
+                if (conn_pre[e] != (uint32_t)s.pop) continue;
+                int32_t w = conn_w[e];
+                int32_t* in = in_cur[conn_post[e]];
+                uint32_t n = pop_size[conn_post[e]];
+                for (uint32_t j = 0; j < n; ++j) in[j] += w;
+            }}
+        }}
+#else
+        while (evq_tail != evq_head) {{
+            evq_tail = (evq_tail + 1u) & EVQ_MASK;
+            events++;
+        }}
+#endif
+        uint32_t pc = rdcycle();
+        uint32_t pi = rdinstret();
+        prop_cycles += pc - mc;
+        prop_instret += pi - mi;
+    }}
 
     uint32_t c1 = rdcycle();
     uint32_t i1 = rdinstret();
     uint32_t dc = c1 - c0;
     uint32_t di = i1 - i0;
 
-    /* JSONL lines */
-    uart_puts("{{\"metric\":\"kernel.step_ns\",\"value\":"); print_u32(dc); uart_puts(",\"labels\":{{\"graph\":\"");
-    uart_puts(graph); uart_puts("\",\"backend\":\""); uart_puts(backend); uart_puts("\",\"isa\":\""); uart_puts(isa);
-    uart_puts("\",\"simulator\":\""); uart_puts(simulator); uart_puts("\"}}}}\\n");
-
-    uart_puts("{{\"metric\":\"events.processed\",\"value\":"); print_u32(100000u); uart_puts(",\"labels\":{{\"graph\":\"");
-    uart_puts(graph); uart_puts("\",\"backend\":\""); uart_puts(backend); uart_puts("\",\"isa\":\""); uart_puts(isa);
-    uart_puts("\",\"simulator\":\""); uart_puts(simulator); uart_puts("\"}}}}\\n");
-
-    uart_puts("{{\"metric\":\"cpu.cycle\",\"value\":"); print_u32(dc); uart_puts(",\"labels\":{{\"graph\":\"");
-    uart_puts(graph); uart_puts("\",\"backend\":\""); uart_puts(backend); uart_puts("\",\"isa\":\""); uart_puts(isa);
-    uart_puts("\",\"simulator\":\""); uart_puts(simulator); uart_puts("\"}}}}\\n");
+    print_metric(graph, "kernel.step_ns", dc / N_STEPS, NULL);
+    print_metric(graph, "events.processed", events, NULL);
+    print_metric(graph, "events.dropped", evq_dropped, NULL);
+    print_metric(graph, "cpu.cycle", dc, NULL);
+    print_metric(graph, "cpu.instret", di, NULL);
+    print_metric(graph, "kernel.stage_cycles", update_cycles, "{update}");
+    print_metric(graph, "kernel.stage_instret", update_instret, "{update}");
+    print_metric(graph, "kernel.stage_cycles", prop_cycles, "spike_propagate");
+    print_metric(graph, "kernel.stage_instret", prop_instret, "spike_propagate");
 
-    uart_puts("{{\"metric\":\"cpu.instret\",\"value\":"); print_u32(di); uart_puts(",\"labels\":{{\"graph\":\"");
-    uart_puts(graph); uart_puts("\",\"backend\":\""); uart_puts(backend); uart_puts("\",\"isa\":\""); uart_puts(isa);
-    uart_puts("\",\"simulator\":\""); uart_puts(simulator); uart_puts("\"}}}}\\n");
-
-    (void)acc;
     qemu_exit(0);
     for(;;) {{ }}
     return 0;
 }}
-"#);
-    fs::write(out_dir.join("main.c"), c_src.as_bytes())?;
+"#,
+        cap = evq_capacity,
+        graph_name = graph_name,
+        update = update_stage
+    );
+    fs::write(out_dir.join("main.c"), c.as_bytes())?;
 
     // Provenance
     let mut readme = fs::File::create(out_dir.join("README.txt"))?;
@@ -650,30 +1112,149 @@ fn build_rv32_bare_metal_binary(out_dir: &Path) -> Result<PathBuf> {
 /// Run QEMU system emulator and capture UART stdout to profile.jsonl (or NC_PROFILE_JSONL).
 fn run_qemu_system_and_capture(elf: &Path, out_dir: &Path) -> Result<()> {
     let qemu = detect_tool(&["qemu-system-riscv32"]).ok_or_else(|| anyhow::anyhow!("qemu-system-riscv32 not found"))?;
-    let output = Command::new(qemu)
-        .arg("-nographic")
+    let mut cmd = Command::new(qemu);
+    cmd.arg("-nographic")
         .arg("-machine").arg("virt")
         .arg("-bios").arg("none")
         .arg("-no-reboot")
-        .arg("-kernel").arg(elf)
-        .output()
-        .context("running qemu-system-riscv32")?;
+        .arg("-kernel").arg(elf);
+    stream_capture(cmd, &profile_dest(out_dir), None, false)
+        .context("running qemu-system-riscv32")
+}
 
-    let dest = if let Ok(p) = std::env::var("NC_PROFILE_JSONL") {
+/// JSONL destination for a run: NC_PROFILE_JSONL when set, else the out dir.
+fn profile_dest(out_dir: &Path) -> PathBuf {
+    if let Ok(p) = std::env::var("NC_PROFILE_JSONL") {
         PathBuf::from(p)
     } else {
         out_dir.join("profile.jsonl")
-    };
-    fs::write(&dest, output.stdout)?;
+    }
+}
+
+/// Spawn `cmd` with piped stdout and stream it into `dest` line by line, so
+/// long soak runs never buffer the whole guest output in memory and the JSONL
+/// file is readable while the run is still going. With a `run_id`, every line
+/// that parses as a JSON object gets `labels.run_id` injected; other lines
+/// pass through untouched.
+fn stream_capture(mut cmd: Command, dest: &Path, run_id: Option<&str>, append: bool) -> Result<()> {
+    use std::io::{BufRead, BufReader, BufWriter};
+
+    let mut child = cmd
+        .stdout(std::process::Stdio::piped())
+        .spawn()
+        .with_context(|| format!("spawning {:?}", cmd.get_program()))?;
+    let stdout = child.stdout.take().expect("piped stdout");
+
+    let file = OpenOptions::new()
+        .create(true)
+        .write(true)
+        .append(append)
+        .truncate(!append)
+        .open(dest)
+        .with_context(|| format!("opening {dest:?}"))?;
+    let mut out = BufWriter::new(file);
+    for line in BufReader::new(stdout).lines() {
+        let line = line.context("reading guest stdout")?;
+        if let Some(id) = run_id {
+            if let Ok(mut v) = serde_json::from_str::<serde_json::Value>(&line) {
+                if v.is_object() {
+                    let labels = v
+                        .as_object_mut()
+                        .expect("checked object")
+                        .entry("labels")
+                        .or_insert_with(|| json!({}));
+                    if let Some(l) = labels.as_object_mut() {
+                        l.insert("run_id".to_string(), json!(id));
+                    }
+                    writeln!(out, "{v}")?;
+                    continue;
+                }
+            }
+        }
+        writeln!(out, "{line}")?;
+    }
+    out.flush()?;
+    child.wait().context("waiting for guest")?;
     Ok(())
 }
 
+/// One entry in a batch execution: a compiled user-mode binary, its artifact
+/// directory, and the id used to tag every record it emits.
+#[derive(Debug, Clone)]
+pub struct BatchRun {
+    pub run_id: String,
+    pub exe: PathBuf,
+    pub out_dir: PathBuf,
+}
+
+/// Execute compiled rv64 Linux binaries concurrently under qemu-riscv64 with
+/// at most `jobs` guests in flight, streaming each guest's output into its
+/// profile destination tagged with `labels.run_id`. Records append, so sweeps
+/// pointing every run at one NC_PROFILE_JSONL file interleave safely at line
+/// granularity.
+pub fn run_qemu_batch(runs: &[BatchRun], jobs: usize) -> Result<()> {
+    let qemu = detect_tool(&["qemu-riscv64"])
+        .ok_or_else(|| anyhow::anyhow!("qemu-riscv64 not found"))?;
+    run_batch_with(runs, jobs, |r| {
+        let mut cmd = Command::new(&qemu);
+        cmd.arg(&r.exe);
+        cmd
+    })
+}
+
+/// Bounded job pool over `runs`: `jobs` workers pull the next run off a shared
+/// counter and stream-capture it. Failures are collected and reported together
+/// so one bad run does not hide the rest of the sweep.
+fn run_batch_with<F>(runs: &[BatchRun], jobs: usize, make_cmd: F) -> Result<()>
+where
+    F: Fn(&BatchRun) -> Command + Sync,
+{
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use std::sync::Mutex;
+
+    let next = AtomicUsize::new(0);
+    let failures: Mutex<Vec<String>> = Mutex::new(Vec::new());
+    let workers = jobs.min(runs.len()).max(1);
+    std::thread::scope(|s| {
+        for _ in 0..workers {
+            s.spawn(|| loop {
+                let idx = next.fetch_add(1, Ordering::Relaxed);
+                let Some(run) = runs.get(idx) else { break };
+                let dest = profile_dest(&run.out_dir);
+                if let Err(e) = stream_capture(make_cmd(run), &dest, Some(&run.run_id), true) {
+                    failures.lock().expect("batch failures").push(format!("{}: {e}", run.run_id));
+                }
+            });
+        }
+    });
+    let failures = failures.into_inner().expect("batch failures");
+    if failures.is_empty() {
+        Ok(())
+    } else {
+        anyhow::bail!("{} of {} batch runs failed: {}", failures.len(), runs.len(), failures.join("; "))
+    }
+}
+
 fn default_out_dir(graph_name: &str, target_name: &str) -> PathBuf {
     PathBuf::from(format!("target/{target_name}-{graph_name}"))
 }
 
+/// Map a population name to a C identifier fragment (lowercase alnum, '_' otherwise).
+fn c_ident(name: &str) -> String {
+    let mut s: String = name
+        .chars()
+        .map(|c| if c.is_ascii_alphanumeric() { c.to_ascii_lowercase() } else { '_' })
+        .collect();
+    if s.is_empty() || s.chars().next().is_some_and(|c| c.is_ascii_digit()) {
+        s.insert(0, 'p');
+    }
+    s
+}
+
 #[allow(clippy::uninlined_format_args)]
 fn emit_linux_rv64_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<()> {
+    use std::fmt::Write as _;
+
     if !out_dir.exists() {
         fs::create_dir_all(out_dir)?;
     }
@@ -692,19 +1273,22 @@ fn emit_linux_rv64_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &nc_
         "op_fuse_scalar"
     };
 
-    // Try to read vectorization metadata from in-graph attributes first
-    let mut vector_enabled = graph.attributes
-        .get("rv_vectorize")
-        .and_then(|v| v.get("enabled"))
-        .and_then(|x| x.as_bool())
+    // Vectorization metadata: typed side-table, then in-graph attributes.
+    let mut vector_enabled = graph.meta.rv_vectorize.as_ref().map(|v| v.enabled)
+        .or_else(|| graph.attributes
+            .get("rv_vectorize")
+            .and_then(|v| v.get("enabled"))
+            .and_then(|x| x.as_bool()))
         .unwrap_or(false);
-    let mut vlen_bytes: u64 = graph.attributes
-        .get("rv_vectorize")
-        .and_then(|v| v.get("vlen_bytes"))
-        .and_then(|x| x.as_u64())
+    let mut vlen_bytes: u64 = graph.meta.rv_vectorize.as_ref().map(|v| v.vlen_bytes)
+        .or_else(|| graph.attributes
+            .get("rv_vectorize")
+            .and_then(|v| v.get("vlen_bytes"))
+            .and_then(|x| x.as_u64()))
         .unwrap_or(0);
 
-    // Fall back to pass dumps if the input graph doesn't carry pass attributes
+    // Fall back to pass dumps if the input graph doesn't carry pass attributes.
+    // Dumps are full graph snapshots, so the pass output lives under "attributes".
     if !vector_enabled || vlen_bytes == 0 {
         let passes_dir = out_dir.join("passes");
         if let Ok(rd) = fs::read_dir(&passes_dir) {
@@ -712,7 +1296,11 @@ fn emit_linux_rv64_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &nc_
                 if e.file_name().to_string_lossy().contains("rv-vectorize") {
                     if let Ok(s) = fs::read_to_string(e.path()) {
                         if let Ok(val) = serde_json::from_str::<serde_json::Value>(&s) {
-                            if let Some(rv) = val.get("rv_vectorize") {
+                            let rv = val
+                                .get("attributes")
+                                .and_then(|a| a.get("rv_vectorize"))
+                                .or_else(|| val.get("rv_vectorize"));
+                            if let Some(rv) = rv {
                                 if let Some(b) = rv.get("enabled").and_then(|x| x.as_bool()) {
                                     vector_enabled = b;
                                 }
@@ -728,16 +1316,93 @@ fn emit_linux_rv64_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &nc_
         }
     }
 
-    let c_src = format!(
-r#"#include <stdio.h>
+    // Thread schedule from rv-schedule (typed side-table, in-graph attribute,
+    // or pass dump fallback).
+    let mut sched_threads: u64 = graph.meta.rv_schedule.as_ref().map(|s| s.threads)
+        .or_else(|| graph.attributes
+            .get("rv_schedule")
+            .and_then(|v| v.get("threads"))
+            .and_then(|x| x.as_u64()))
+        .unwrap_or(0);
+    let mut thread_of: std::collections::HashMap<String, u64> = std::collections::HashMap::new();
+    if let Some(s) = &graph.meta.rv_schedule {
+        for (pop, t) in &s.assignment {
+            thread_of.insert(pop.clone(), *t);
+        }
+    }
+    let collect_assignment = |v: &serde_json::Value, out: &mut std::collections::HashMap<String, u64>| {
+        if let Some(assign) = v.get("assignment").and_then(|a| a.as_array()) {
+            for a in assign {
+                if let (Some(pop), Some(t)) = (
+                    a.get("population").and_then(|x| x.as_str()),
+                    a.get("thread").and_then(|x| x.as_u64()),
+                ) {
+                    out.insert(pop.to_string(), t);
+                }
+            }
+        }
+    };
+    if thread_of.is_empty() {
+        if let Some(v) = graph.attributes.get("rv_schedule") {
+            collect_assignment(v, &mut thread_of);
+        }
+    }
+    if sched_threads == 0 || thread_of.is_empty() {
+        let passes_dir = out_dir.join("passes");
+        if let Ok(rd) = fs::read_dir(&passes_dir) {
+            for e in rd.flatten() {
+                if e.file_name().to_string_lossy().contains("rv-schedule") {
+                    if let Ok(s) = fs::read_to_string(e.path()) {
+                        if let Ok(val) = serde_json::from_str::<serde_json::Value>(&s) {
+                            if let Some(rs) = val.get("attributes").and_then(|a| a.get("rv_schedule")) {
+                                if sched_threads == 0 {
+                                    sched_threads = rs.get("threads").and_then(|x| x.as_u64()).unwrap_or(0);
+                                }
+                                if thread_of.is_empty() {
+                                    collect_assignment(rs, &mut thread_of);
+                                }
+                            }
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    let n_threads = sched_threads.max(1) as usize;
+
+    // Populations drive codegen. An empty graph still gets a minimal self-driven
+    // population so the artifact remains buildable and produces metrics.
+    // Tuple: (original name, C identifier, size, model, thread).
+    let pops: Vec<(String, String, u32, String, usize)> = if graph.populations.is_empty() {
+        vec![("pop0".to_string(), "pop0".to_string(), 1024u32, "lif".to_string(), 0)]
+    } else {
+        graph.populations.iter()
+            .map(|p| {
+                let t = thread_of.get(&p.name).copied().unwrap_or(0) as usize % n_threads;
+                (p.name.clone(), c_ident(&p.name), p.size.max(1), p.model.to_lowercase(), t)
+            })
+            .collect()
+    };
+    // Connections resolved to population indices (skip any that reference unknown pops).
+    let pop_index = |name: &str| pops.iter().position(|(n, _, _, _, _)| n == name);
+    let conns: Vec<(usize, usize, f32)> = graph.connections.iter()
+        .filter_map(|c| Some((pop_index(&c.pre)?, pop_index(&c.post)?, c.weight)))
+        .collect();
+
+    let mut c = String::new();
+    let _ = write!(c, r#"#include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
 
 /* RISC-V pass metadata (from pipeline/config):
  *  - align_bytes={align}
  *  - quant_bits_default={qbits}
  *  - fused_stages={fused}
+ *  - threads={threads}
  *  - rvv_enabled={rvv}
  *  - vlen_bytes={vlen}
  */
@@ -747,6 +1412,15 @@ r#"#include <stdio.h>
   #include <riscv_vector.h>
 #endif
 
+#define ALIGN_BYTES {align}u
+#define N_STEPS_DEFAULT 1000u
+
+/* LIF dynamics shared by all generated populations; per-population params
+ * come from NIR population attributes (defaults when absent). */
+#define LIF_DECAY 0.95f
+#define LIF_V_TH  1.0f
+#define SOURCE_PERIOD 10u /* source populations fire every SOURCE_PERIOD steps */
+
 static inline uint64_t now_ns() {{
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -762,91 +1436,232 @@ static inline uint64_t rdcycle(void) {{ return 0ull; }}
 static inline uint64_t rdinstret(void) {{ return 0ull; }}
 #endif
 
-int main(void) {{
-    const char* graph = "{graph}";
-    const char* backend = "riscv";
+/* SoA state arrays are allocated on ALIGN_BYTES boundaries (rv-layout). */
+static void* alloc_aligned(size_t bytes) {{
+    void* p = NULL;
+    if (posix_memalign(&p, ALIGN_BYTES, bytes) != 0 || p == NULL) {{
+        fprintf(stderr, "alloc_aligned(%zu) failed\n", bytes);
+        exit(1);
+    }}
+    memset(p, 0, bytes);
+    return p;
+}}
+
+/* Fused LIF membrane update + threshold for one population over SoA state.
+ * The RVV path strip-mines decay+integrate over the hardware vector length
+ * (vlen_bytes={vlen} per rv-vectorize); threshold/reset stays scalar. */
+static uint32_t lif_step(float* restrict v_m, float* restrict in_cur, size_t n) {{
+    uint32_t fired = 0;
+#if defined(__riscv_vector)
+    size_t i = 0;
+    while (i < n) {{
+        size_t vl = vsetvl_e32m8(n - i);
+        vfloat32m8_t v = vle32_v_f32m8(&v_m[i], vl);
+        vfloat32m8_t cur = vle32_v_f32m8(&in_cur[i], vl);
+        v = vfmul_vf_f32m8(v, LIF_DECAY, vl);
+        v = vfadd_vv_f32m8(v, cur, vl);
+        vse32_v_f32m8(&v_m[i], v, vl);
+        i += vl;
+    }}
+#else
+    for (size_t i = 0; i < n; ++i) {{
+        v_m[i] = v_m[i] * LIF_DECAY + in_cur[i];
+    }}
+#endif
+    for (size_t i = 0; i < n; ++i) {{
+        if (v_m[i] >= LIF_V_TH) {{
+            v_m[i] = 0.0f;
+            fired++;
+        }}
+        in_cur[i] = 0.0f;
+    }}
+    return fired;
+}}
+
+"#,
+        align = align_bytes,
+        qbits = quant_bits_default,
+        fused = fused_stage,
+        threads = n_threads,
+        rvv = vector_enabled,
+        vlen = vlen_bytes
+    );
+
+    // Per-population sizes
+    for (name, id, size, model, thread) in &pops {
+        let _ = writeln!(
+            c,
+            "#define N_{up} {size}u /* population '{name}' model={model} thread={thread} */",
+            up = id.to_uppercase()
+        );
+    }
+    let _ = writeln!(c);
+    let _ = writeln!(c, "#define N_THREADS {n_threads}u");
+    let _ = writeln!(c, "#define N_POPS {}u", pops.len());
+    let _ = writeln!(c, "#define N_CONNS {}u", conns.len());
+    let _ = writeln!(c);
+
+    // Static schedule tables (rv-schedule pass): sizes, models, owner threads.
+    let _ = writeln!(c, "static const uint32_t pop_size[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| format!("N_{}", p.1.to_uppercase())));
+    let _ = writeln!(c, "static const uint8_t pop_is_source[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| if p.3 == "source" { "1".to_string() } else { "0".to_string() }));
+    let _ = writeln!(c, "static const uint32_t pop_thread[N_POPS] = {{ {} }};",
+        join_table(&pops, |p| format!("{}u", p.4)));
+    if !conns.is_empty() {
+        let _ = writeln!(c, "static const uint32_t conn_pre[N_CONNS] = {{ {} }};",
+            conns.iter().map(|(p, _, _)| format!("{p}u")).collect::<Vec<_>>().join(", "));
+        let _ = writeln!(c, "static const uint32_t conn_post[N_CONNS] = {{ {} }};",
+            conns.iter().map(|(_, p, _)| format!("{p}u")).collect::<Vec<_>>().join(", "));
+        let _ = writeln!(c, "static const float conn_w[N_CONNS] = {{ {} }};",
+            conns.iter().map(|(_, _, w)| format!("{w:.6}f")).collect::<Vec<_>>().join(", "));
+        for (i, (pre, post, _)) in conns.iter().enumerate() {
+            let _ = writeln!(c, "/* conn #{i}: {} -> {} */", pops[*pre].0, pops[*post].0);
+        }
+    }
+    let _ = writeln!(c);
+
+    let _ = write!(c, r#"/* Shared simulation state. fired[] is written in the update stage by each
+ * population's owner thread and read in the propagation stage after a
+ * barrier; in_cur[p] is only ever touched by pop_thread[p]. */
+static float* v_m[N_POPS];
+static float* in_cur[N_POPS];
+static uint32_t fired[N_POPS];
+static uint64_t thread_events[N_THREADS];
+static pthread_barrier_t step_barrier;
+static uint32_t g_steps;
+
+static void* worker(void* arg) {{
+    uint32_t tid = (uint32_t)(uintptr_t)arg;
+    uint64_t events = 0;
+    for (uint32_t step = 0; step < g_steps; ++step) {{
+        /* Stage 1: update populations owned by this thread. */
+        for (uint32_t p = 0; p < N_POPS; ++p) {{
+            if (pop_thread[p] != tid) continue;
+            uint32_t f;
+            if (pop_is_source[p]) {{
+                f = (step % SOURCE_PERIOD == 0u) ? pop_size[p] : 0u;
+            }} else {{
+                f = lif_step(v_m[p], in_cur[p], pop_size[p]);
+            }}
+            fired[p] = f;
+            events += f;
+        }}
+        pthread_barrier_wait(&step_barrier);
+#if N_CONNS > 0
+        /* Stage 2: accumulate spikes into populations owned by this thread. */
+        for (uint32_t e = 0; e < N_CONNS; ++e) {{
+            uint32_t post = conn_post[e];
+            if (pop_thread[post] != tid) continue;
+            uint32_t f = fired[conn_pre[e]];
+            if (f == 0u) continue;
+            float contrib = conn_w[e] * (float)f;
+            float* in = in_cur[post];
+            uint32_t n = pop_size[post];
+            for (uint32_t j = 0; j < n; ++j) in[j] += contrib;
+        }}
+#endif
+        pthread_barrier_wait(&step_barrier);
+    }}
+    thread_events[tid] = events;
+    return NULL;
+}}
+
+"#);
+
+    let _ = writeln!(c, "int main(void) {{");
+    let _ = writeln!(c, "    const char* graph = \"{graph_name}\";");
+    let _ = write!(c, r#"    const char* backend = "riscv";
     const char* isa = "rv64gcv";
     const char* simulator = "qemu";
 
+    uint32_t n_steps = N_STEPS_DEFAULT;
+    const char* steps_env = getenv("NC_STEPS");
+    if (steps_env) {{
+        unsigned long v = strtoul(steps_env, NULL, 10);
+        if (v > 0) n_steps = (uint32_t)v;
+    }}
+    g_steps = n_steps;
+
+    /* SoA state per population: membrane potential and input accumulator. */
+    for (uint32_t p = 0; p < N_POPS; ++p) {{
+        v_m[p] = (float*)alloc_aligned(pop_size[p] * sizeof(float));
+        in_cur[p] = (float*)alloc_aligned(pop_size[p] * sizeof(float));
+    }}
+    if (pthread_barrier_init(&step_barrier, NULL, N_THREADS) != 0) {{
+        fprintf(stderr, "pthread_barrier_init failed\n");
+        return 1;
+    }}
+
     uint64_t c0 = rdcycle();
     uint64_t i0 = rdinstret();
-
     uint64_t t0 = now_ns();
 
-    /* Workloop: vectorized sum-reduction with scalar fallback */
-#if defined(__riscv_vector)
-    size_t n = 100000;
-    uint64_t* data = (uint64_t*)malloc(n * sizeof(uint64_t));
-    if (!data) return 1;
-    for (size_t ii = 0; ii < n; ++ii) {{ data[ii] = (uint64_t)ii; }}
-
-    size_t ii = 0;
-    size_t vl1 = vsetvl_e64m1(1);
-    vuint64m1_t v_acc = vmv_v_x_u64m1(0, vl1);
-    while (ii < n) {{
-        size_t vl = vsetvl_e64m8(n - ii);
-        vuint64m8_t v_data = vle64_v_u64m8(&data[ii], vl);
-        v_acc = vredsum_vs_u64m8_u64m1(v_data, v_acc, vl);
-        ii += vl;
+    pthread_t tids[N_THREADS];
+    for (uint32_t t = 0; t < N_THREADS; ++t) {{
+        if (pthread_create(&tids[t], NULL, worker, (void*)(uintptr_t)t) != 0) {{
+            fprintf(stderr, "pthread_create(%u) failed\n", t);
+            return 1;
+        }}
+    }}
+    for (uint32_t t = 0; t < N_THREADS; ++t) {{
+        pthread_join(tids[t], NULL);
     }}
-    uint64_t sum = vmv_x_s_u64m1_u64(v_acc);
-    volatile uint64_t acc = sum;
-    free(data);
-#else
-    volatile uint64_t acc = 0;
-    for (size_t i = 0; i < 100000; ++i) {{ acc += (uint64_t)i; }}
-#endif
 
     uint64_t t1 = now_ns();
-
     uint64_t c1 = rdcycle();
     uint64_t i1 = rdinstret();
 
-    double step_ns = (double)(t1 - t0);
-    printf("{{\"metric\":\"kernel.step_ns\",\"value\":%.0f,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n", step_ns, graph, backend, isa, simulator);
-    printf("{{\"metric\":\"events.processed\",\"value\":%d,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n", 100000, graph, backend, isa, simulator);
-    printf("{{\"metric\":\"cpu.cycle\",\"value\":%llu,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
+    uint64_t events = 0;
+    for (uint32_t t = 0; t < N_THREADS; ++t) events += thread_events[t];
+
+    pthread_barrier_destroy(&step_barrier);
+    for (uint32_t p = 0; p < N_POPS; ++p) {{
+        free(v_m[p]);
+        free(in_cur[p]);
+    }}
+
+    double step_ns = (double)(t1 - t0) / (double)n_steps;
+    printf("{{\"metric\":\"kernel.step_ns\",\"value\":%.0f,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\n", step_ns, graph, backend, isa, simulator);
+    printf("{{\"metric\":\"events.processed\",\"value\":%llu,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\n",
+           (unsigned long long)events, graph, backend, isa, simulator);
+    printf("{{\"metric\":\"runtime.threads\",\"value\":%u,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\n",
+           (unsigned)N_THREADS, graph, backend, isa, simulator);
+    printf("{{\"metric\":\"cpu.cycle\",\"value\":%llu,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\n",
            (unsigned long long)(c1 - c0), graph, backend, isa, simulator);
-    printf("{{\"metric\":\"cpu.instret\",\"value\":%llu,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
+    printf("{{\"metric\":\"cpu.instret\",\"value\":%llu,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\n",
            (unsigned long long)(i1 - i0), graph, backend, isa, simulator);
-    (void)acc;
     return 0;
 }}
-"#,
-        graph = graph_name,
-        align = align_bytes,
-        qbits = quant_bits_default,
-        fused = fused_stage,
-        rvv = vector_enabled,
-        vlen = vlen_bytes
-    );
+"#);
 
     let main_c = out_dir.join("main.c");
     let mut f = fs::File::create(&main_c)?;
-    f.write_all(c_src.as_bytes())?;
+    f.write_all(c.as_bytes())?;
     f.flush()?;
 
     // Write a simple README for artifact provenance
     let mut readme = fs::File::create(out_dir.join("README.txt"))?;
     writeln!(
         readme,
-        "Generated RV64 Linux runtime (guarded RVV + scalar) for graph '{graph_name}' targeting '{target_name}'.",
+        "Generated RV64 Linux runtime (SoA LIF kernels, guarded RVV + scalar, pthread workers) for graph '{graph_name}' targeting '{target_name}'.",
     )?;
     writeln!(
         readme,
-        "RVV intent: enabled={}, vlen_bytes={}",
-        vector_enabled, vlen_bytes
+        "Populations={}, connections={}, threads={}; RVV intent: enabled={}, vlen_bytes={}",
+        pops.len(),
+        conns.len(),
+        n_threads,
+        vector_enabled,
+        vlen_bytes
     )?;
     Ok(())
 }
 
+/// Resolve the first available candidate via the process-wide registry;
+/// every probe after the first for a given tool is a cache hit.
 fn detect_tool(candidates: &[&str]) -> Option<String> {
-    for c in candidates {
-        if Command::new("sh").arg("-lc").arg(format!("command -v {c}")).status().ok()?.success() {
-            return Some((*c).to_string());
-        }
-    }
-    None
+    candidates.iter().find_map(|c| toolchain::resolve(c))
 }
 
 fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
@@ -900,6 +1715,7 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
             // Try GCC with RVV (static, then dynamic)
             let status = Command::new(&cc)
                 .arg("-O2")
+                .arg("-pthread")
                 .arg("-static")
                 .arg("-march=rv64gcv")
                 .arg("-o")
@@ -913,6 +1729,7 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
             }
             let status2 = Command::new(&cc)
                 .arg("-O2")
+                .arg("-pthread")
                 .arg("-march=rv64gcv")
                 .arg("-o")
                 .arg(&exe)
@@ -929,6 +1746,7 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
         // Scalar fallback (static then dynamic)
         let status3 = Command::new(&cc)
             .arg("-O2")
+            .arg("-pthread")
             .arg("-static")
             .arg("-o")
             .arg(&exe)
@@ -944,6 +1762,7 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
         }
         let status4 = Command::new(&cc)
             .arg("-O2")
+            .arg("-pthread")
             .arg("-o")
             .arg(&exe)
             .arg(&main_c)
@@ -963,6 +1782,7 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
             let status = Command::new(&clang)
                 .arg("--target=riscv64-unknown-linux-gnu")
                 .arg("-O2")
+                .arg("-pthread")
                 .arg("-march=rv64gcv")
                 .arg("-o")
                 .arg(&exe)
@@ -979,6 +1799,7 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
         let status2 = Command::new(&clang)
             .arg("--target=riscv64-unknown-linux-gnu")
             .arg("-O2")
+            .arg("-pthread")
             .arg("-o")
             .arg(&exe)
             .arg(&main_c)
@@ -1002,18 +1823,9 @@ fn build_rv64_linux_binary(out_dir: &Path) -> Result<PathBuf> {
 
 fn run_qemu_and_capture(exe: &Path, out_dir: &Path) -> Result<()> {
     let qemu = detect_tool(&["qemu-riscv64"]).ok_or_else(|| anyhow::anyhow!("qemu-riscv64 not found"))?;
-    let output = Command::new(qemu)
-        .arg(exe)
-        .output()
-        .context("running qemu-riscv64")?;
-    // Decide JSONL destination
-    let dest = if let Ok(p) = std::env::var("NC_PROFILE_JSONL") {
-        PathBuf::from(p)
-    } else {
-        out_dir.join("profile.jsonl")
-    };
-    fs::write(&dest, output.stdout)?;
-    Ok(())
+    let mut cmd = Command::new(qemu);
+    cmd.arg(exe);
+    stream_capture(cmd, &profile_dest(out_dir), None, false).context("running qemu-riscv64")
 }
 
 /// Emit control-plane artifacts: main.c, accelerator.repl, accelerator.py, run.resc
@@ -1030,6 +1842,8 @@ fn emit_control_plane_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &
     // Fall back to manifest capabilities if pass data not available
     let _mmio_supported = caps.and_then(|c| c.mmio_supported).unwrap_or(false);
     let dma_supported = caps.and_then(|c| c.dma_supported).unwrap_or(false);
+    // Descriptor stride: each ring entry sits on a dma_alignment boundary.
+    let dma_alignment = caps.and_then(|c| c.dma_alignment).unwrap_or(64);
 
     // Generate main.c - Linux user-space program using mmap to access MMIO
     let main_c = format!(r#"#include <stdio.h>
@@ -1048,8 +1862,10 @@ fn emit_control_plane_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &
 // Accelerator register offsets
 #define ACCEL_CTRL      0x00  // Control register
 #define ACCEL_STATUS    0x04  // Status register
-#define DMA_ADDR        0x08  // DMA address register
-#define DMA_LEN         0x0C  // DMA length register
+#define DMA_RING_BASE   0x08  // Descriptor ring base address
+#define DMA_RING_ENTRIES 0x0C // Descriptor ring capacity
+#define DMA_RING_HEAD   0x10  // Producer index (doorbell: one write per batch)
+#define DMA_RING_TAIL   0x14  // Completion index (advanced by the device)
 
 // Control register bits
 #define CTRL_START      (1 << 0)
@@ -1059,12 +1875,41 @@ fn emit_control_plane_runtime(out_dir: &Path, graph: &nc_nir::Graph, manifest: &
 #define STATUS_DONE     (1 << 0)
 #define STATUS_BUSY     (1 << 1)
 
+// In-memory DMA descriptor ring: each entry is padded out to a dma_alignment
+// boundary ({dma_align} bytes per manifest capabilities).
+#define DMA_ALIGNMENT   {dma_align}u
+#define DMA_RING_CAP    16u
+#define DMA_BATCH       8u
+#define DESC_VALID      (1u << 0)
+#define DESC_LAST       (1u << 1)  // closes a batch
+
+typedef struct {{
+    uint64_t addr;
+    uint32_t len;
+    uint32_t flags;
+}} __attribute__((aligned(DMA_ALIGNMENT))) dma_desc_t;
+
 static inline uint64_t now_ns() {{
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
     return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
 }}
 
+/* Spin until *reg >= want with exponential backoff (no sleeping: the 1ms
+ * usleep floor dominated offload latency). Returns 1 on success, 0 on
+ * timeout after ~2^24 total backoff iterations. */
+static int spin_until_ge(volatile uint32_t* reg, uint32_t want) {{
+    uint32_t backoff = 1;
+    uint64_t spent = 0;
+    while (*reg < want) {{
+        for (volatile uint32_t i = 0; i < backoff; ++i) {{ }}
+        spent += backoff;
+        if (backoff < (1u << 12)) backoff <<= 1;
+        if (spent > (1ull << 24)) return 0;
+    }}
+    return 1;
+}}
+
 int main(void) {{
     const char* graph = "{graph_name}";
     const char* backend = "riscv";
@@ -1092,46 +1937,77 @@ int main(void) {{
     }}
 
     uint64_t t0 = now_ns();
+    uint32_t mmio_ops = 0;
+    uint32_t submitted = 0;
 
     printf("Mapped MMIO region at 0x%lx\\n", MMIO_BASE_ADDR);
 
     // Reset accelerator
     printf("Resetting accelerator...\\n");
     mmio_base[ACCEL_CTRL/4] = CTRL_RESET;
-    usleep(1000); // 1ms delay
     mmio_base[ACCEL_CTRL/4] = 0;
+    mmio_ops += 2;
 
-    // Configure DMA (dummy operation)
     if ({dma_supported}) {{
-        printf("Configuring DMA...\\n");
-        mmio_base[DMA_ADDR/4] = 0x80000000; // Dummy DMA address
-        mmio_base[DMA_LEN/4] = 1024;        // Dummy DMA length
+        // Build the descriptor ring and a dma_alignment-aligned payload buffer.
+        dma_desc_t* ring = aligned_alloc(DMA_ALIGNMENT, DMA_RING_CAP * sizeof(dma_desc_t));
+        void* payload = aligned_alloc(DMA_ALIGNMENT, DMA_BATCH * 1024);
+        if (!ring || !payload) {{
+            fprintf(stderr, "aligned_alloc for DMA ring failed\\n");
+            munmap((void*)mmio_base, MMIO_SIZE);
+            close(mem_fd);
+            return 1;
+        }}
+        memset(ring, 0, DMA_RING_CAP * sizeof(dma_desc_t));
+
+        // Fill one batch of descriptors; a single doorbell write submits it.
+        for (uint32_t i = 0; i < DMA_BATCH; ++i) {{
+            ring[i].addr = (uint64_t)(uintptr_t)payload + (uint64_t)i * 1024;
+            ring[i].len = 1024;
+            ring[i].flags = DESC_VALID | (i + 1 == DMA_BATCH ? DESC_LAST : 0);
+        }}
+
+        printf("Submitting DMA batch: %u descriptors, one doorbell\\n", DMA_BATCH);
+        mmio_base[DMA_RING_BASE/4] = (uint32_t)(uintptr_t)ring;
+        mmio_base[DMA_RING_ENTRIES/4] = DMA_RING_CAP;
+        mmio_base[DMA_RING_HEAD/4] = DMA_BATCH; // doorbell
+        mmio_ops += 3;
+        submitted = DMA_BATCH;
+
+        // Spin on the completion index instead of sleeping.
+        if (!spin_until_ge(&mmio_base[DMA_RING_TAIL/4], DMA_BATCH)) {{
+            printf("DMA batch timed out (tail=%u)\\n", mmio_base[DMA_RING_TAIL/4]);
+        }} else {{
+            printf("DMA batch completed (tail=%u)\\n", mmio_base[DMA_RING_TAIL/4]);
+        }}
+
+        free(payload);
+        free(ring);
     }}
 
     // Start accelerator operation
     printf("Starting accelerator operation...\\n");
     mmio_base[ACCEL_CTRL/4] = CTRL_START;
+    mmio_ops += 1;
 
-    // Poll for completion
-    int timeout = 1000; // 1000ms timeout
-    uint32_t status;
-    do {{
+    // Spin (with backoff) for completion: no usleep in the hot path.
+    uint32_t status = 0;
+    uint32_t backoff = 1;
+    uint64_t spent = 0;
+    for (;;) {{
         status = mmio_base[ACCEL_STATUS/4];
-        if (status & STATUS_DONE) {{
-            break;
-        }}
-        usleep(1000); // 1ms delay
-        timeout--;
-    }} while (timeout > 0);
-
-    uint64_t t1 = now_ns();
-
-    if (timeout == 0) {{
-        printf("Operation timed out!\\n");
-    }} else {{
+        if (status & STATUS_DONE) break;
+        for (volatile uint32_t i = 0; i < backoff; ++i) {{ }}
+        spent += backoff;
+        if (backoff < (1u << 12)) backoff <<= 1;
+        if (spent > (1ull << 24)) {{ printf("Operation timed out!\\n"); break; }}
+    }}
+    if (status & STATUS_DONE) {{
         printf("Operation completed successfully\\n");
     }}
 
+    uint64_t t1 = now_ns();
+
     // Read final status
     status = mmio_base[ACCEL_STATUS/4];
     printf("Final status: 0x%08x\\n", status);
@@ -1141,10 +2017,12 @@ int main(void) {{
     // Output telemetry in JSONL format
     printf("{{\"metric\":\"kernel.step_ns\",\"value\":%.0f,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
            step_ns, graph, backend, isa, simulator);
-    printf("{{\"metric\":\"events.processed\",\"value\":%d,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
-           1, graph, backend, isa, simulator);
-    printf("{{\"metric\":\"mmio.operations\",\"value\":%d,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
-           {dma_supported} ? 5 : 3, graph, backend, isa, simulator);
+    printf("{{\"metric\":\"events.processed\",\"value\":%u,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
+           submitted > 0 ? submitted : 1, graph, backend, isa, simulator);
+    printf("{{\"metric\":\"dma.batch_size\",\"value\":%u,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
+           submitted, graph, backend, isa, simulator);
+    printf("{{\"metric\":\"mmio.operations\",\"value\":%u,\"labels\":{{\"graph\":\"%s\",\"backend\":\"%s\",\"isa\":\"%s\",\"simulator\":\"%s\"}}}}\\n",
+           mmio_ops, graph, backend, isa, simulator);
 
     // Cleanup
     munmap((void*)mmio_base, MMIO_SIZE);
@@ -1155,6 +2033,7 @@ int main(void) {{
 "#,
         mmio_base = mmio_base_addr,
         graph_name = graph_name,
+        dma_align = dma_alignment,
         dma_supported = if dma_supported { "1" } else { "0" }
     );
 
@@ -1178,7 +2057,9 @@ showAnalyzer sysbus.uart0
 
     fs::write(out_dir.join("accelerator.repl"), repl_content)?;
 
-    // Generate accelerator.py - Python model for the SNN_Accelerator peripheral
+    // Generate accelerator.py - Python model for the SNN_Accelerator peripheral.
+    // The descriptor stride must match the C side's DMA_ALIGNMENT padding, so
+    // the one manifest-dependent line is patched into the template below.
     let py_content = r#"from Antmicro.Renode.Peripherals import IDoubleWordPeripheral
 from Antmicro.Renode.Peripherals.Bus import BusRangeRegistration
 from Antmicro.Renode.Core import Range
@@ -1187,23 +2068,47 @@ class SNNAccelerator(IDoubleWordPeripheral):
     def __init__(self):
         self.ctrl_reg = 0
         self.status_reg = 0
-        self.dma_addr_reg = 0
-        self.dma_len_reg = 0
+        self.ring_base = 0
+        self.ring_entries = 0
+        self.ring_head = 0
+        self.ring_tail = 0
         self.operation_active = False
-        
+
     def ReadDoubleWord(self, offset):
         if offset == 0x00:  # ACCEL_CTRL
             return self.ctrl_reg
         elif offset == 0x04:  # ACCEL_STATUS
             return self.status_reg
-        elif offset == 0x08:  # DMA_ADDR
-            return self.dma_addr_reg
-        elif offset == 0x0C:  # DMA_LEN
-            return self.dma_len_reg
+        elif offset == 0x08:  # DMA_RING_BASE
+            return self.ring_base
+        elif offset == 0x0C:  # DMA_RING_ENTRIES
+            return self.ring_entries
+        elif offset == 0x10:  # DMA_RING_HEAD
+            return self.ring_head
+        elif offset == 0x14:  # DMA_RING_TAIL (completion index)
+            return self.ring_tail
         else:
             print(f"[SNN_Accelerator] Read from unknown offset 0x{offset:02x}")
             return 0
-            
+
+    def consume_ring(self):
+        # Consume descriptors [tail, head): read each entry from guest memory
+        # when the sysbus is reachable, then advance the completion index.
+        count = self.ring_head - self.ring_tail
+        stride = 64  # dma_alignment-padded descriptor stride
+        for i in range(self.ring_tail, self.ring_head):
+            addr = self.ring_base + (i % max(self.ring_entries, 1)) * stride
+            try:
+                lo = self.machine.SystemBus.ReadDoubleWord(addr)
+                hi = self.machine.SystemBus.ReadDoubleWord(addr + 4)
+                length = self.machine.SystemBus.ReadDoubleWord(addr + 8)
+                flags = self.machine.SystemBus.ReadDoubleWord(addr + 12)
+                print(f"[SNN_Accelerator] desc #{i}: addr=0x{(hi << 32) | lo:x} len={length} flags=0x{flags:x}")
+            except Exception:
+                pass  # register-level model without bus access
+        self.ring_tail = self.ring_head
+        print(f"[SNN_Accelerator] DMA batch consumed: {count} descriptors, tail={self.ring_tail}")
+
     def WriteDoubleWord(self, offset, value):
         if offset == 0x00:  # ACCEL_CTRL
             self.ctrl_reg = value
@@ -1218,26 +2123,39 @@ class SNNAccelerator(IDoubleWordPeripheral):
             elif value & 0x2:  # CTRL_RESET
                 print("[SNN_Accelerator] Accelerator control register written: RESET")
                 self.status_reg = 0
+                self.ring_head = 0
+                self.ring_tail = 0
                 self.operation_active = False
         elif offset == 0x04:  # ACCEL_STATUS (read-only, but allow writes for testing)
             print(f"[SNN_Accelerator] Status register write attempted: 0x{value:08x}")
-        elif offset == 0x08:  # DMA_ADDR
-            self.dma_addr_reg = value
-            print(f"[SNN_Accelerator] DMA transfer configured: addr=0x{value:08x}")
-        elif offset == 0x0C:  # DMA_LEN
-            self.dma_len_reg = value
-            print(f"[SNN_Accelerator] DMA transfer configured: len={value}")
+        elif offset == 0x08:  # DMA_RING_BASE
+            self.ring_base = value
+            print(f"[SNN_Accelerator] DMA ring configured: base=0x{value:08x}")
+        elif offset == 0x0C:  # DMA_RING_ENTRIES
+            self.ring_entries = value
+            print(f"[SNN_Accelerator] DMA ring configured: entries={value}")
+        elif offset == 0x10:  # DMA_RING_HEAD (doorbell: one write submits a batch)
+            self.ring_head = value
+            self.consume_ring()
+        elif offset == 0x14:  # DMA_RING_TAIL (device-owned)
+            print(f"[SNN_Accelerator] Tail register write attempted: 0x{value:08x}")
         else:
             print(f"[SNN_Accelerator] Write to unknown offset 0x{offset:02x}: 0x{value:08x}")
 
     def Reset(self):
         self.ctrl_reg = 0
         self.status_reg = 0
-        self.dma_addr_reg = 0
-        self.dma_len_reg = 0
+        self.ring_base = 0
+        self.ring_entries = 0
+        self.ring_head = 0
+        self.ring_tail = 0
         self.operation_active = False
         print("[SNN_Accelerator] Reset")
 "#;
+    let py_content = py_content.replace(
+        "stride = 64  # dma_alignment-padded descriptor stride",
+        &format!("stride = {dma_alignment}  # dma_alignment-padded descriptor stride"),
+    );
 
     fs::write(out_dir.join("accelerator.py"), py_content)?;
 
@@ -1320,11 +2238,84 @@ fn run_renode_and_capture(exe: &Path, out_dir: &Path) -> Result<()> {
     Ok(())
 }
 
+/// Driver for the shared backend fan-out (`nc_backend_common::compile_many`).
+pub struct Driver;
+impl nc_backend_common::BackendDriver for Driver {
+    fn name(&self) -> &str { "riscv" }
+    fn compile_prevalidated(&self, graph: &nc_nir::Graph, manifest: &nc_hal::TargetManifest) -> Result<String> {
+        compile_prevalidated(graph, manifest)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
     use std::path::PathBuf;
 
+    #[test]
+    fn toolchain_registry_resolves_once_and_consistently() {
+        // `sh` exists everywhere we build; repeated lookups must agree and
+        // come back as an invocable path, not a bare name.
+        let first = detect_tool(&["sh"]).expect("sh on PATH");
+        let second = detect_tool(&["sh"]).expect("sh on PATH");
+        assert_eq!(first, second);
+        assert!(Path::new(&first).is_absolute());
+        assert!(detect_tool(&["definitely-not-a-real-tool-xyz"]).is_none());
+    }
+
+    #[test]
+    fn stream_capture_tags_json_lines_with_run_id() {
+        let dir = std::env::temp_dir().join("nc_riscv_stream_capture");
+        fs::create_dir_all(&dir).unwrap();
+        let dest = dir.join("capture.jsonl");
+
+        let mut cmd = Command::new("sh");
+        cmd.arg("-c").arg(r#"printf '{"metric":"m","value":1,"labels":{}}\nnot json\n'"#);
+        stream_capture(cmd, &dest, Some("run-a"), false).unwrap();
+
+        let s = fs::read_to_string(&dest).unwrap();
+        let mut lines = s.lines();
+        let first: serde_json::Value = serde_json::from_str(lines.next().unwrap()).unwrap();
+        assert_eq!(first["labels"]["run_id"], "run-a");
+        assert_eq!(lines.next().unwrap(), "not json");
+
+        // Append mode interleaves a second run instead of clobbering.
+        let mut cmd = Command::new("sh");
+        cmd.arg("-c").arg(r#"printf '{"metric":"m","value":2}\n'"#);
+        stream_capture(cmd, &dest, Some("run-b"), true).unwrap();
+        let s = fs::read_to_string(&dest).unwrap();
+        assert!(s.contains("run-a") && s.contains("run-b"));
+        assert_eq!(s.lines().count(), 3);
+    }
+
+    #[test]
+    fn batch_runner_executes_every_run_with_bounded_pool() {
+        let base = std::env::temp_dir().join("nc_riscv_batch_runner");
+        let runs: Vec<BatchRun> = (0..5)
+            .map(|i| {
+                let out_dir = base.join(format!("run{i}"));
+                fs::create_dir_all(&out_dir).unwrap();
+                let _ = fs::remove_file(profile_dest(&out_dir));
+                BatchRun {
+                    run_id: format!("run{i}"),
+                    exe: PathBuf::from("unused"),
+                    out_dir,
+                }
+            })
+            .collect();
+        run_batch_with(&runs, 2, |r| {
+            let mut cmd = Command::new("sh");
+            cmd.arg("-c")
+                .arg(format!(r#"printf '{{"metric":"kernel.step_ns","value":%d}}\n' {}"#, r.run_id.len()));
+            cmd
+        })
+        .unwrap();
+        for r in &runs {
+            let s = fs::read_to_string(profile_dest(&r.out_dir)).unwrap();
+            assert!(s.contains(&format!("\"run_id\":\"{}\"", r.run_id)), "missing tag in {s}");
+        }
+    }
+
     #[test]
     fn compile_smoke() {
         let g = nc_nir::Graph::new("g");
@@ -1342,6 +2333,34 @@ mod tests {
         let _ = compile(&g, &m).unwrap();
     }
 
+    #[test]
+    fn compile_cache_hits_on_unchanged_input() {
+        let g = nc_nir::Graph::new("cachehit");
+        let m = nc_hal::parse_target_manifest_str(r#"
+            name = "riscv64gcv_linux"
+            vendor = "Generic"
+            family = "RISC-V"
+            version = "1"
+            [capabilities]
+            weight_precisions = [8]
+            max_neurons_per_core = 1
+            max_synapses_per_core = 1
+            time_resolution_ns = 1
+        "#).unwrap();
+        let a1 = compile(&g, &m).unwrap();
+        let out_dir = PathBuf::from(a1.trim_start_matches("artifact:"));
+        assert!(out_dir.join("cache.key").exists(), "cache key written after compile");
+        // A cache hit returns early without re-emitting sources.
+        fs::remove_file(out_dir.join("main.c")).unwrap();
+        let a2 = compile(&g, &m).unwrap();
+        assert_eq!(a1, a2);
+        assert!(!out_dir.join("main.c").exists(), "cache hit must not re-emit main.c");
+        // A stale key forces a full recompile.
+        fs::write(out_dir.join("cache.key"), "stale").unwrap();
+        let _ = compile(&g, &m).unwrap();
+        assert!(out_dir.join("main.c").exists(), "miss should re-emit main.c");
+    }
+
     #[test]
     fn pipeline_integration_smoke() {
         // Use the real manifest file for riscv64gcv_linux and ensure main.c is emitted
@@ -1432,6 +2451,181 @@ mod tests {
         assert!(found, "rv-control-plane-driver dump not found in {passes:?}");
     }
 
+    #[test]
+    fn linux_emit_generates_graph_kernels() {
+        let g = nc_nir::fixtures::chain(&[4, 8]);
+        let m = nc_hal::parse_target_manifest_str(r#"
+            name = "riscv64gcv_linux"
+            vendor = "Generic"
+            family = "RISC-V"
+            version = "1"
+            [capabilities]
+            weight_precisions = [8]
+            max_neurons_per_core = 100
+            max_synapses_per_core = 100
+            time_resolution_ns = 1
+            cacheline_bytes = 64
+        "#).unwrap();
+        let out_dir = default_out_dir(&g.name, &m.name);
+        emit_linux_rv64_runtime(&out_dir, &g, &m).unwrap();
+        let s = fs::read_to_string(out_dir.join("main.c")).unwrap();
+        // SoA state arrays per population, sized from the graph
+        assert!(s.contains("#define N_P0 4u"), "population size macro missing");
+        assert!(s.contains("#define N_P1 8u"), "population size macro missing");
+        assert!(s.contains("pop_size[N_POPS] = { N_P0, N_P1 }"), "population size table missing");
+        // LIF kernel and spike propagation for the chain edge
+        assert!(s.contains("lif_step(v_m[p], in_cur[p], pop_size[p])"), "LIF update call missing");
+        assert!(s.contains("conn #0: p0 -> p1"), "spike propagation for chain edge missing");
+        // Alignment comes from the manifest cacheline
+        assert!(s.contains("#define ALIGN_BYTES 64u"), "alignment macro missing");
+        // Threaded runtime scaffolding
+        assert!(s.contains("pthread_barrier_wait"), "barrier sync missing");
+        assert!(s.contains("pop_thread[N_POPS]"), "thread assignment table missing");
+    }
+
+    #[test]
+    fn control_plane_emit_generates_dma_descriptor_ring() {
+        let g = nc_nir::Graph::new("ctrl-ring");
+        let m = nc_hal::parse_target_manifest_str(r#"
+            name = "riscv64gc_ctrl_ring"
+            vendor = "Generic"
+            family = "RISC-V"
+            version = "1"
+            [capabilities]
+            weight_precisions = [8]
+            max_neurons_per_core = 100
+            max_synapses_per_core = 100
+            time_resolution_ns = 1
+            mmio_supported = true
+            mmio_base_addr = 0x40000000
+            dma_supported = true
+            dma_alignment = 128
+        "#).unwrap();
+        let out_dir = default_out_dir(&g.name, &m.name);
+        emit_control_plane_runtime(&out_dir, &g, &m).unwrap();
+        let s = fs::read_to_string(out_dir.join("main.c")).unwrap();
+        // Descriptor ring sized/aligned from manifest dma_alignment
+        assert!(s.contains("#define DMA_ALIGNMENT   128u"), "dma_alignment not honored");
+        assert!(s.contains("dma_desc_t"), "descriptor struct missing");
+        // Batch submit via a single doorbell write, completion via spinning
+        assert!(s.contains("mmio_base[DMA_RING_HEAD/4] = DMA_BATCH; // doorbell"), "doorbell write missing");
+        assert!(s.contains("spin_until_ge(&mmio_base[DMA_RING_TAIL/4]"), "completion spin missing");
+        assert!(!s.contains("usleep("), "polling sleep should be gone");
+        // Renode model consumes the ring on doorbell writes
+        let py = fs::read_to_string(out_dir.join("accelerator.py")).unwrap();
+        assert!(py.contains("DMA_RING_HEAD"), "head register missing from model");
+        assert!(py.contains("consume_ring"), "model does not consume the ring");
+        assert!(py.contains("stride = 128"), "model stride must match DMA_ALIGNMENT");
+    }
+
+    #[test]
+    fn bare_metal_emit_generates_event_driven_kernel() {
+        let mut g = nc_nir::fixtures::chain(&[4, 8]);
+        g.attributes.insert("rv_layout".to_string(), json!({ "align_bytes": 32 }));
+        g.attributes.insert("rv_schedule".to_string(), json!({
+            "threads": 1,
+            "fused_stages": ["op_fuse_vadd_vmul"],
+            "assignment": []
+        }));
+        let m = nc_hal::parse_target_manifest_str(r#"
+            name = "riscv32imac_bare"
+            vendor = "Generic"
+            family = "RISC-V"
+            version = "1"
+            [capabilities]
+            weight_precisions = [8]
+            max_neurons_per_core = 100
+            max_synapses_per_core = 100
+            time_resolution_ns = 1
+        "#).unwrap();
+        let out_dir = default_out_dir(&g.name, &m.name);
+        emit_bare_metal_runtime(&out_dir, &g, &m).unwrap();
+        let s = fs::read_to_string(out_dir.join("main.c")).unwrap();
+        // Per-population state arrays, sized from the graph and aligned per rv-layout
+        assert!(s.contains("#define N_P0 4u"), "population size macro missing");
+        assert!(s.contains("#define ALIGN_BYTES 32u"), "rv-layout alignment not honored");
+        assert!(s.contains("static int32_t v_p0[N_P0] __attribute__((aligned(ALIGN_BYTES)));"),
+            "aligned per-population state array missing");
+        // Statically sized spike ring buffer
+        assert!(s.contains("static spike_t evq[EVQ_CAPACITY]"), "spike ring buffer missing");
+        assert!(s.contains("evq_push"), "ring push missing");
+        // Connection table in Q10 fixed point for the chain edge
+        assert!(s.contains("conn #0: p0 -> p1"), "spike propagation for chain edge missing");
+        assert!(s.contains("/* Q10 */"), "fixed-point weight table missing");
+        // Per-stage counters labelled with the fused stage from rv-schedule
+        assert!(s.contains("\"kernel.stage_cycles\", update_cycles, \"op_fuse_vadd_vmul\""),
+            "fused stage cycle metric missing");
+        assert!(s.contains("\"spike_propagate\""), "propagation stage metric missing");
+    }
+
+    #[test]
+    fn schedule_pass_balances_populations_across_threads() {
+        let g = nc_nir::fixtures::chain(&[64, 32, 16]);
+        let out = RvSchedulePass.run(g).unwrap();
+        let sched = out.attributes.get("rv_schedule").expect("rv_schedule attr");
+        let threads = sched.get("threads").and_then(|x| x.as_u64()).unwrap();
+        assert_eq!(threads, 3, "three populations should map onto three threads");
+        let assign = sched.get("assignment").and_then(|a| a.as_array()).unwrap();
+        assert_eq!(assign.len(), 3);
+        // LPT greedy over equal thread count: every population gets its own thread
+        let mut seen: Vec<u64> = assign.iter()
+            .map(|a| a.get("thread").and_then(|x| x.as_u64()).unwrap())
+            .collect();
+        seen.sort_unstable();
+        assert_eq!(seen, vec![0, 1, 2]);
+    }
+
+    #[test]
+    fn schedule_pass_honors_partition_assignment() {
+        let mut g = nc_nir::fixtures::chain(&[8, 8]);
+        g.attributes.insert("partition".to_string(), json!({
+            "parts": 2,
+            "assignment": [
+                { "population": "p0", "part": 0 },
+                { "population": "p1", "part": 1 }
+            ]
+        }));
+        let out = RvSchedulePass.run(g).unwrap();
+        let sched = out.attributes.get("rv_schedule").expect("rv_schedule attr");
+        assert_eq!(sched.get("threads").and_then(|x| x.as_u64()), Some(2));
+        let assign = sched.get("assignment").and_then(|a| a.as_array()).unwrap();
+        let t1 = assign.iter()
+            .find(|a| a.get("population").and_then(|x| x.as_str()) == Some("p1"))
+            .and_then(|a| a.get("thread"))
+            .and_then(|x| x.as_u64());
+        assert_eq!(t1, Some(1), "partition part should become the owner thread");
+    }
+
+    #[test]
+    fn rv_pipeline_fills_typed_pass_meta() {
+        let mut g = nc_nir::fixtures::chain(&[8, 8]);
+        g.meta.partition = Some(nc_nir::PartitionAssignment {
+            parts: 2,
+            assignment: vec![("p0".into(), 0), ("p1".into(), 1)],
+        });
+        g.attributes.insert("caps_riscv".to_string(), json!({
+            "align_bytes": 64,
+            "vector_available": true
+        }));
+        let g = RvLayoutPass.run(g).unwrap();
+        let g = RvSchedulePass.run(g).unwrap();
+        let g = RvVectorizePass.run(g).unwrap();
+
+        let layout = g.meta.rv_layout.as_ref().expect("typed rv_layout");
+        assert_eq!(layout.align_bytes, 64);
+        assert!(layout.vector_available);
+        let sched = g.meta.rv_schedule.as_ref().expect("typed rv_schedule");
+        assert_eq!(sched.threads, 2, "typed partition drives the thread count");
+        assert!(sched.assignment.contains(&("p1".to_string(), 1)));
+        let vec = g.meta.rv_vectorize.as_ref().expect("typed rv_vectorize");
+        assert_eq!(vec.vlen_bytes, layout.vector_bytes);
+        // The JSON attributes stay in lockstep for serialization.
+        assert_eq!(
+            g.attributes.get("rv_vectorize").and_then(|v| v.get("vlen_bytes")).and_then(|x| x.as_u64()),
+            Some(vec.vlen_bytes)
+        );
+    }
+
     #[test]
     fn qemu_user_smoke_if_available() {
         // Skip if toolchain or qemu not present
@@ -48,9 +48,13 @@ struct ImportArgs {
     /// Frontend/framework name (e.g., pynn, nengo, nest, brian, bindsnet, carlsim, genn, rockpool)
     #[arg(long)]
     framework: Option<String>,
-    /// Optional format override (e.g., py, json, yaml)
+    /// Optional format override (e.g., py, json, yaml, jsonl)
     #[arg(long)]
     format: Option<String>,
+    /// Streaming output: write a binary NIR container here instead of
+    /// materializing the graph (jsonl input only)
+    #[arg(long)]
+    output: Option<PathBuf>,
 }
 
 #[derive(Args, Debug)]
@@ -70,6 +74,10 @@ struct LowerArgs {
     /// Optional builtin target name (fallback convenience to load targets/<name>.toml)
     #[arg(long)]
     target: Option<String>,
+    /// Reuse JSON stage dumps under --dump-dir as a pass cache, skipping
+    /// passes whose input is unchanged since the previous run
+    #[arg(long)]
+    cache: bool,
 }
 
 #[derive(Args, Debug)]
@@ -77,9 +85,10 @@ struct CompileArgs {
     /// Input NIR file (JSON or YAML)
     #[arg(long)]
     input: PathBuf,
-    /// Target backend (e.g., loihi2, akida, spinnaker2)
-    #[arg(long)]
-    target: String,
+    /// Target backend(s); repeat the flag or comma-separate
+    /// (e.g., --target loihi2,riscv64gcv_linux)
+    #[arg(long, value_delimiter = ',', num_args = 1..)]
+    target: Vec<String>,
 }
 
 #[derive(Args, Debug)]
@@ -103,6 +112,20 @@ struct ProfileArgs {
     /// Path to run directory or results
     #[arg(long)]
     input: Option<PathBuf>,
+    /// Report p50/p95/p99 per metric (parallel sketch over large JSONL)
+    #[arg(long)]
+    percentiles: bool,
+    /// Compare two profile JSONL files: --diff baseline.jsonl current.jsonl.
+    /// Exits nonzero when a budgeted metric regresses past its budget.
+    #[arg(long, num_args = 2, value_names = ["BASELINE", "CURRENT"])]
+    diff: Vec<PathBuf>,
+    /// Per-metric regression budgets as metric=percent
+    /// (e.g. --budget kernel.step_ns=5,backend.compile_ms=10)
+    #[arg(long = "budget", value_delimiter = ',')]
+    budget: Vec<String>,
+    /// Budget percent applied to metrics without an explicit --budget entry
+    #[arg(long)]
+    default_budget: Option<f64>,
 }
 
 #[derive(Args, Debug)]
@@ -110,6 +133,10 @@ struct PackageArgs {
     /// Output artifact path
     #[arg(long)]
     output: Option<PathBuf>,
+    /// Artifact directory to stream into a seekable .ncpk container
+    /// (generated sources, ELFs, pass dumps, profile JSONL)
+    #[arg(long)]
+    input: Option<PathBuf>,
 }
 
 #[derive(Args, Debug)]
@@ -117,6 +144,12 @@ struct DeployArgs {
     /// Target backend/hardware or cluster
     #[arg(long)]
     target: String,
+    /// Optional .ncpk package; only this target's members are unpacked
+    #[arg(long)]
+    package: Option<PathBuf>,
+    /// Destination for unpacked members (default target/deploy-<target>)
+    #[arg(long)]
+    dest: Option<PathBuf>,
 }
 
 #[derive(Args, Debug)]
@@ -124,6 +157,120 @@ struct ExportMlirArgs {
     /// Input NIR file (JSON or YAML)
     #[arg(long)]
     input: PathBuf,
+    /// Output file (streamed; stdout when omitted)
+    #[arg(long)]
+    output: Option<PathBuf>,
+    /// Emit compact binary bytecode instead of textual MLIR (requires --output)
+    #[arg(long)]
+    bytecode: bool,
+}
+
+/// Compile an already parsed and validated graph for one target. Each backend
+/// writes to its own default_out_dir, so concurrent calls for different
+/// targets are independent; the target-agnostic front half (parse, validate,
+/// version tag) happens once in the caller, so this dispatches to each
+/// backend's `compile_prevalidated` rather than the revalidating `compile`.
+fn compile_for_target(g: &nc_nir::Graph, target: &str) -> Result<String, String> {
+    let manifest_path = PathBuf::from(format!("targets/{target}.toml"));
+    // Shared manifest store: validated once per process, with embedded builtin
+    // fallback when no targets/ directory is present.
+    let manifest = nc_hal::manifest_for_path(&manifest_path)
+        .map_err(|e| format!("cannot load manifest {manifest_path:?}: {e}"))?;
+    let _ = (&g, &manifest);
+
+    match target {
+        "loihi2" => {
+            #[cfg(feature = "backend-loihi")]
+            {
+                nc_backend_loihi::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-loihi"))]
+            {
+                Err("backend 'backend-loihi' is not enabled; rebuild CLI with --features backend-loihi".to_string())
+            }
+        }
+        "truenorth" => {
+            #[cfg(feature = "backend-truenorth")]
+            {
+                nc_backend_truenorth::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-truenorth"))]
+            {
+                Err("backend 'backend-truenorth' is not enabled; rebuild CLI with --features backend-truenorth".to_string())
+            }
+        }
+        "akida" => {
+            #[cfg(feature = "backend-akida")]
+            {
+                nc_backend_akida::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-akida"))]
+            {
+                Err("backend 'backend-akida' is not enabled; rebuild CLI with --features backend-akida".to_string())
+            }
+        }
+        "spinnaker2" => {
+            #[cfg(feature = "backend-spinnaker")]
+            {
+                nc_backend_spinnaker::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-spinnaker"))]
+            {
+                Err("backend 'backend-spinnaker' is not enabled; rebuild CLI with --features backend-spinnaker".to_string())
+            }
+        }
+        "neurogrid" => {
+            #[cfg(feature = "backend-neurogrid")]
+            {
+                nc_backend_neurogrid::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-neurogrid"))]
+            {
+                Err("backend 'backend-neurogrid' is not enabled; rebuild CLI with --features backend-neurogrid".to_string())
+            }
+        }
+        "dynaps" => {
+            #[cfg(feature = "backend-dynaps")]
+            {
+                nc_backend_dynaps::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-dynaps"))]
+            {
+                Err("backend 'backend-dynaps' is not enabled; rebuild CLI with --features backend-dynaps".to_string())
+            }
+        }
+        "memxbar" => {
+            #[cfg(feature = "backend-memxbar")]
+            {
+                nc_backend_memxbar::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-memxbar"))]
+            {
+                Err("backend 'backend-memxbar' is not enabled; rebuild CLI with --features backend-memxbar".to_string())
+            }
+        }
+        "custom_asic" => {
+            #[cfg(feature = "backend-custom-asic")]
+            {
+                nc_backend_custom_asic::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-custom-asic"))]
+            {
+                Err("backend 'backend-custom-asic' is not enabled; rebuild CLI with --features backend-custom-asic".to_string())
+            }
+        }
+        "riscv64gcv_linux" | "riscv32imac_bare" | "riscv64gc_ctrl" => {
+            #[cfg(feature = "backend-riscv")]
+            {
+                nc_backend_riscv::compile_prevalidated(g, &manifest).map_err(|e| format!("compile error: {e}"))
+            }
+            #[cfg(not(feature = "backend-riscv"))]
+            {
+                Err("backend 'backend-riscv' is not enabled; rebuild CLI with --features backend-riscv".to_string())
+            }
+        }
+        other => Err(format!("unsupported or not yet integrated target '{other}'")),
+    }
 }
 
 fn main() {
@@ -160,6 +307,74 @@ fn main() {
                 .map(|s| s.to_lowercase())
                 .or_else(|| args.input.extension().and_then(|e| e.to_str()).map(|s| s.to_lowercase()));
 
+            // JSONL exports stream record-by-record through a GraphSink, so
+            // import memory stays bounded by one record. With --output the
+            // records go straight into a binary NIR container; without it the
+            // sink is an in-memory graph and the usual summary is printed.
+            if fmt.as_deref() == Some("jsonl") {
+                #[cfg(feature = "frontend-nest")]
+                {
+                    let file = match fs::File::open(&args.input) {
+                        Ok(f) => f,
+                        Err(e) => {
+                            eprintln!("import: cannot read {:?}: {e}", args.input);
+                            return;
+                        }
+                    };
+                    let reader = std::io::BufReader::new(file);
+                    let default_name = args
+                        .input
+                        .file_stem()
+                        .and_then(|s| s.to_str())
+                        .unwrap_or("imported")
+                        .to_string();
+                    if let Some(out) = &args.output {
+                        let mut sink = match nc_nir::container::StreamingWriter::create(out, default_name) {
+                            Ok(w) => w,
+                            Err(e) => {
+                                eprintln!("import: cannot create {out:?}: {e}");
+                                return;
+                            }
+                        };
+                        match nc_frontend_nest::import_jsonl(reader, &mut sink).and_then(|s| {
+                            sink.finish()?;
+                            Ok(s)
+                        }) {
+                            Ok(stats) => println!(
+                                "import ok (streamed): populations={} connections={} probes={} -> {:?}",
+                                stats.populations, stats.connections, stats.probes, out
+                            ),
+                            Err(e) => eprintln!("import stream error: {e}"),
+                        }
+                    } else {
+                        let mut g = nc_nir::Graph::new(default_name);
+                        match nc_frontend_nest::import_jsonl(reader, &mut g) {
+                            Ok(_) => {
+                                let valid = g.validate().is_ok();
+                                println!(
+                                    "import ok: name={} populations={} connections={} probes={} valid={}",
+                                    g.name,
+                                    g.populations.len(),
+                                    g.connections.len(),
+                                    g.probes.len(),
+                                    valid
+                                );
+                            }
+                            Err(e) => eprintln!("import parse error: {e}"),
+                        }
+                    }
+                }
+                #[cfg(not(feature = "frontend-nest"))]
+                {
+                    eprintln!("import: jsonl streaming requires the 'frontend-nest' feature; rebuild CLI with --features frontend-nest");
+                }
+                return;
+            }
+            if args.output.is_some() {
+                eprintln!("import: --output is only supported for jsonl streaming input");
+                return;
+            }
+
             let data = match fs::read_to_string(&args.input) {
                 Ok(d) => d,
                 Err(e) => {
@@ -220,6 +435,7 @@ fn main() {
                 passes: names.clone(),
                 dump_dir: args.dump_dir.clone(),
                 dump_formats: if fmt.is_empty() { vec![nc_passes::DumpFormat::Json] } else { fmt },
+                cache: args.cache,
             };
 
             // Build a trivial graph and run through the pipeline with dumps
@@ -230,16 +446,15 @@ fn main() {
                 .clone()
                 .or_else(|| args.target.as_ref().map(|t| PathBuf::from(format!("targets/{t}.toml"))));
             if let Some(mp) = manifest_path {
-                match nc_hal::parse_target_manifest_path(&mp) {
-                    Ok(m) => {
-                        if let Err(e) = nc_hal::validate_manifest(&m) {
-                            eprintln!("lower: manifest invalid: {e}");
-                        } else {
-                            g.attributes.insert(
-                                "hal_manifest_path".to_string(),
-                                serde_json::json!(mp.to_string_lossy().to_string()),
-                            );
-                        }
+                // manifest_for_path validates and primes the process-wide store,
+                // so capability-aware passes resolving the attached path below
+                // reuse the same parsed manifest.
+                match nc_hal::manifest_for_path(&mp) {
+                    Ok(_) => {
+                        g.attributes.insert(
+                            "hal_manifest_path".to_string(),
+                            serde_json::json!(mp.to_string_lossy().to_string()),
+                        );
                     }
                     Err(e) => {
                         eprintln!("lower: cannot load manifest {mp:?}: {e}");
@@ -293,167 +508,36 @@ fn main() {
             }
             g.ensure_version_tag();
 
-            // Load target manifest
-            let manifest_path = PathBuf::from(format!("targets/{}.toml", args.target));
-            let manifest = match nc_hal::parse_target_manifest_path(&manifest_path) {
-                Ok(m) => m,
-                Err(e) => {
-                    eprintln!("compile: cannot load manifest {manifest_path:?}: {e}");
-                    return;
-                }
-            };
-            if let Err(e) = nc_hal::validate_manifest(&manifest) {
-                eprintln!("compile: manifest invalid: {e}");
-                return;
-            }
-
-            match args.target.as_str() {
-                "loihi2" => {
-                    #[cfg(feature = "backend-loihi")]
-                    {
-                        match nc_backend_loihi::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-loihi"))]
-                    {
-                        eprintln!("backend 'backend-loihi' is not enabled; rebuild CLI with --features backend-loihi");
-                    }
-                }
-                "truenorth" => {
-                    #[cfg(feature = "backend-truenorth")]
-                    {
-                        match nc_backend_truenorth::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-truenorth"))]
-                    {
-                        eprintln!("backend 'backend-truenorth' is not enabled; rebuild CLI with --features backend-truenorth");
-                    }
-                }
-                "akida" => {
-                    #[cfg(feature = "backend-akida")]
-                    {
-                        match nc_backend_akida::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-akida"))]
-                    {
-                        eprintln!("backend 'backend-akida' is not enabled; rebuild CLI with --features backend-akida");
-                    }
-                }
-                "spinnaker2" => {
-                    #[cfg(feature = "backend-spinnaker")]
-                    {
-                        match nc_backend_spinnaker::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-spinnaker"))]
-                    {
-                        eprintln!("backend 'backend-spinnaker' is not enabled; rebuild CLI with --features backend-spinnaker");
-                    }
-                }
-                "neurogrid" => {
-                    #[cfg(feature = "backend-neurogrid")]
-                    {
-                        match nc_backend_neurogrid::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-neurogrid"))]
-                    {
-                        eprintln!("backend 'backend-neurogrid' is not enabled; rebuild CLI with --features backend-neurogrid");
-                    }
-                }
-                "dynaps" => {
-                    #[cfg(feature = "backend-dynaps")]
-                    {
-                        match nc_backend_dynaps::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-dynaps"))]
-                    {
-                        eprintln!("backend 'backend-dynaps' is not enabled; rebuild CLI with --features backend-dynaps");
-                    }
-                }
-                "memxbar" => {
-                    #[cfg(feature = "backend-memxbar")]
-                    {
-                        match nc_backend_memxbar::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-memxbar"))]
-                    {
-                        eprintln!("backend 'backend-memxbar' is not enabled; rebuild CLI with --features backend-memxbar");
-                    }
-                }
-                "custom_asic" => {
-                    #[cfg(feature = "backend-custom-asic")]
-                    {
-                        match nc_backend_custom_asic::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-custom-asic"))]
-                    {
-                        eprintln!("backend 'backend-custom-asic' is not enabled; rebuild CLI with --features backend-custom-asic");
-                    }
-                }
-                "riscv64gcv_linux" => {
-                    #[cfg(feature = "backend-riscv")]
-                    {
-                        match nc_backend_riscv::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-riscv"))]
-                    {
-                        eprintln!("backend 'backend-riscv' is not enabled; rebuild CLI with --features backend-riscv");
-                    }
-                }
-                "riscv32imac_bare" => {
-                    #[cfg(feature = "backend-riscv")]
-                    {
-                        match nc_backend_riscv::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-riscv"))]
-                    {
-                        eprintln!("backend 'backend-riscv' is not enabled; rebuild CLI with --features backend-riscv");
-                    }
+            // Parse/validate once, then fan compiles out; every backend owns
+            // its out dir so the per-target work is independent.
+            if args.target.len() == 1 {
+                match compile_for_target(&g, &args.target[0]) {
+                    Ok(art) => println!("compile ok: {art}"),
+                    Err(e) => eprintln!("compile: {e}"),
                 }
-                "riscv64gc_ctrl" => {
-                    #[cfg(feature = "backend-riscv")]
-                    {
-                        match nc_backend_riscv::compile(&g, &manifest) {
-                            Ok(art) => println!("compile ok: {}", art),
-                            Err(e) => eprintln!("compile error: {e}"),
-                        }
-                    }
-                    #[cfg(not(feature = "backend-riscv"))]
-                    {
-                        eprintln!("backend 'backend-riscv' is not enabled; rebuild CLI with --features backend-riscv");
+            } else {
+                let g = &g;
+                let results: Vec<(String, Result<String, String>)> =
+                    std::thread::scope(|scope| {
+                        let handles: Vec<_> = args
+                            .target
+                            .iter()
+                            .map(|t| {
+                                let t = t.clone();
+                                scope.spawn(move || {
+                                    let r = compile_for_target(g, &t);
+                                    (t, r)
+                                })
+                            })
+                            .collect();
+                        handles.into_iter().map(|h| h.join().expect("compile worker")).collect()
+                    });
+                for (t, r) in results {
+                    match r {
+                        Ok(art) => println!("compile ok [{t}]: {art}"),
+                        Err(e) => eprintln!("compile [{t}]: {e}"),
                     }
                 }
-                other => {
-                    eprintln!("compile: unsupported or not yet integrated target '{other}'");
-                }
             }
         }
         Some(Command::Simulate(args)) => {
@@ -554,6 +638,36 @@ fn main() {
                         println!("simulate disabled: feature 'sim-hw-specific' not enabled; rebuild CLI with --features sim-hw-specific");
                     }
                 }
+                // In-process reference engine: no external simulator install,
+                // no feature gate. Step count via NC_STEPS (default 100).
+                "reference" => {
+                    let steps = std::env::var("NC_STEPS").ok()
+                        .and_then(|v| v.parse().ok())
+                        .unwrap_or(100);
+                    let cfg = nc_runtime::reference::SimConfig { steps, ..Default::default() };
+                    match nc_runtime::reference::run(&g, &cfg) {
+                        Ok(r) => {
+                            let report = serde_json::json!({
+                                "simulator": "reference",
+                                "graph": g.name,
+                                "steps": r.steps,
+                                "events": r.events,
+                                "spikes_per_population": r.spikes_per_population
+                                    .iter()
+                                    .map(|(name, n)| serde_json::json!({ "population": name, "spikes": n }))
+                                    .collect::<Vec<_>>(),
+                            });
+                            let write = fs::create_dir_all(&out_dir).and_then(|()| {
+                                fs::write(out_dir.join("sim_report.json"), serde_json::to_string_pretty(&report).unwrap_or_default())
+                            });
+                            match write {
+                                Ok(()) => println!("simulate reference ok: {} steps, {} events; report in {:?}", r.steps, r.events, out_dir),
+                                Err(e) => eprintln!("simulate: cannot write report: {e}"),
+                            }
+                        }
+                        Err(e) => eprintln!("simulate error: {e}"),
+                    }
+                }
                 other => {
                     println!("simulate unsupported: {other}");
                 }
@@ -569,9 +683,89 @@ fn main() {
             }
         }
         Some(Command::Profile(args)) => {
+            if args.diff.len() == 2 {
+                #[cfg(feature = "telemetry")]
+                {
+                    use nc_telemetry::profiling::{diff_summaries, summarize_jsonl_by_series};
+                    let mut budgets: std::collections::HashMap<String, f64> = std::collections::HashMap::new();
+                    for spec in &args.budget {
+                        match spec.split_once('=').and_then(|(m, p)| p.parse::<f64>().ok().map(|p| (m, p))) {
+                            Some((m, p)) => { budgets.insert(m.to_string(), p); }
+                            None => {
+                                eprintln!("profile: bad --budget entry '{spec}' (expected metric=percent)");
+                                std::process::exit(2);
+                            }
+                        }
+                    }
+                    let base = match summarize_jsonl_by_series(&args.diff[0]) {
+                        Ok(s) => s,
+                        Err(e) => { eprintln!("profile: baseline {:?}: {e}", args.diff[0]); std::process::exit(2); }
+                    };
+                    let cur = match summarize_jsonl_by_series(&args.diff[1]) {
+                        Ok(s) => s,
+                        Err(e) => { eprintln!("profile: current {:?}: {e}", args.diff[1]); std::process::exit(2); }
+                    };
+                    let deltas = diff_summaries(&base, &cur, &budgets, args.default_budget);
+                    println!("metric,labels,baseline_avg,current_avg,delta_pct,budget_pct,status");
+                    let mut breaches = 0usize;
+                    for d in &deltas {
+                        let labels = d
+                            .labels
+                            .iter()
+                            .map(|(k, v)| format!("{k}={v}"))
+                            .collect::<Vec<_>>()
+                            .join(";");
+                        let status = if d.breached { breaches += 1; "BREACH" }
+                            else if d.baseline_avg.is_nan() { "new" }
+                            else if d.current_avg.is_nan() { "gone" }
+                            else { "ok" };
+                        let budget = d.budget_pct.map(|b| format!("{b:.1}")).unwrap_or_default();
+                        println!(
+                            "{},{},{:.4},{:.4},{:+.2},{},{}",
+                            d.metric, labels, d.baseline_avg, d.current_avg, d.delta_pct, budget, status
+                        );
+                    }
+                    if breaches > 0 {
+                        eprintln!("profile: {breaches} metric(s) regressed past budget");
+                        std::process::exit(1);
+                    }
+                    return;
+                }
+                #[cfg(not(feature = "telemetry"))]
+                {
+                    eprintln!("profile --diff requires the telemetry feature; rebuild CLI with --features telemetry");
+                    std::process::exit(2);
+                }
+            }
             if let Some(path) = args.input {
                 #[cfg(feature = "telemetry")]
                 {
+                    if args.percentiles {
+                        match nc_telemetry::profiling::summarize_quantiles_jsonl(&path) {
+                            Ok(sketches) => {
+                                println!("metric,count,p50,p95,p99,min,max");
+                                let mut metrics: Vec<_> = sketches.keys().cloned().collect();
+                                metrics.sort();
+                                for m in metrics {
+                                    let s = &sketches[&m];
+                                    println!(
+                                        "{},{},{:.4},{:.4},{:.4},{:.4},{:.4}",
+                                        m,
+                                        s.count(),
+                                        s.quantile(0.50),
+                                        s.quantile(0.95),
+                                        s.quantile(0.99),
+                                        s.min(),
+                                        s.max()
+                                    );
+                                }
+                            }
+                            Err(e) => {
+                                eprintln!("profile: percentile summarize failed: {e}");
+                            }
+                        }
+                        return;
+                    }
                     match nc_telemetry::profiling::summarize_jsonl(&path) {
                         Ok(stats) => {
                             println!("metric,count,avg,min,max");
@@ -594,30 +788,64 @@ fn main() {
             }
         }
         Some(Command::Package(args)) => {
-            // Minimal packaging: create an output directory and write a metadata file
             let stamp = std::time::SystemTime::now()
                 .duration_since(std::time::UNIX_EPOCH)
                 .map(|d| d.as_secs())
                 .unwrap_or(0);
-            let out_dir = args
-                .output
-                .clone()
-                .unwrap_or_else(|| PathBuf::from(format!("target/package-{stamp}")));
-            if let Err(e) = fs::create_dir_all(&out_dir) {
-                eprintln!("package: cannot create {:?}: {e}", out_dir);
-                return;
-            }
-            let pkg_file = out_dir.join("PKG.txt");
-            let contents = format!(
+            let meta = format!(
                 "neuro-compiler package\ncreated_at_unix={stamp}\ncli_version=0.0.1\n"
             );
-            match fs::write(&pkg_file, contents) {
-                Ok(_) => println!("package created at {:?}", out_dir),
-                Err(e) => eprintln!("package: failed to write {:?}: {e}", pkg_file),
+            match &args.input {
+                Some(dir) => {
+                    // Stream the artifact tree into a seekable zstd container
+                    // with an embedded index; no tar second pass.
+                    let output = args
+                        .output
+                        .clone()
+                        .unwrap_or_else(|| PathBuf::from(format!("target/package-{stamp}.ncpk")));
+                    if let Some(parent) = output.parent() {
+                        let _ = fs::create_dir_all(parent);
+                    }
+                    let packed = nc_runtime::package::PackageWriter::create(&output)
+                        .and_then(|mut w| {
+                            w.add_bytes("PKG.txt", meta.as_bytes())?;
+                            w.add_dir(dir)?;
+                            w.finish()
+                        });
+                    match packed {
+                        Ok(members) => println!(
+                            "package created at {:?} ({} members)",
+                            output,
+                            members.len()
+                        ),
+                        Err(e) => eprintln!("package: {e}"),
+                    }
+                }
+                None => {
+                    // Legacy metadata-only packaging: create an output
+                    // directory and write a metadata file.
+                    let out_dir = args
+                        .output
+                        .clone()
+                        .unwrap_or_else(|| PathBuf::from(format!("target/package-{stamp}")));
+                    if let Err(e) = fs::create_dir_all(&out_dir) {
+                        eprintln!("package: cannot create {:?}: {e}", out_dir);
+                        return;
+                    }
+                    let pkg_file = out_dir.join("PKG.txt");
+                    match fs::write(&pkg_file, meta) {
+                        Ok(_) => println!("package created at {:?}", out_dir),
+                        Err(e) => eprintln!("package: failed to write {:?}: {e}", pkg_file),
+                    }
+                }
             }
         }
         Some(Command::Deploy(args)) => {
-            let spec = nc_runtime::DeploySpec { target: args.target.clone() };
+            let spec = nc_runtime::DeploySpec {
+                target: args.target.clone(),
+                package: args.package.clone(),
+                dest: args.dest.clone(),
+            };
             match nc_runtime::deploy(&spec) {
                 Ok(_) => println!("deploy ok: target={}", args.target),
                 Err(e) => eprintln!("deploy failed: {e}"),
@@ -649,9 +877,37 @@ fn main() {
                     return;
                 }
                 g.ensure_version_tag();
-                match nc_mlir_bridge::lower_to_mlir(&g) {
-                    Ok(s) => println!("{}", s),
-                    Err(e) => eprintln!("mlir: lower failed: {e}"),
+                // Stream straight into the destination: the module text is
+                // never assembled in memory.
+                let lower = |w: &mut dyn std::io::Write| -> anyhow::Result<()> {
+                    if args.bytecode {
+                        nc_mlir_bridge::lower_to_mlir_bytecode_writer(&g, w)
+                    } else {
+                        nc_mlir_bridge::lower_to_mlir_writer(&g, w)
+                    }
+                };
+                let result = match &args.output {
+                    Some(path) => fs::File::create(path)
+                        .map_err(anyhow::Error::from)
+                        .and_then(|f| {
+                            let mut w = std::io::BufWriter::new(f);
+                            lower(&mut w)?;
+                            std::io::Write::flush(&mut w)?;
+                            Ok(())
+                        })
+                        .map(|()| println!("mlir export ok: {}", path.display())),
+                    None if args.bytecode => {
+                        eprintln!("mlir: --bytecode requires --output");
+                        return;
+                    }
+                    None => {
+                        let stdout = std::io::stdout();
+                        let mut w = std::io::BufWriter::new(stdout.lock());
+                        lower(&mut w).and_then(|()| Ok(std::io::Write::flush(&mut w)?))
+                    }
+                };
+                if let Err(e) = result {
+                    eprintln!("mlir: lower failed: {e}");
                 }
             }
             #[cfg(not(feature = "mlir"))]
@@ -106,10 +106,9 @@ fn simulate_smoke_disabled() {
 #[cfg(feature = "telemetry-otlp")]
 #[test]
 fn otlp_init_smoke_lower() {
-    use std::path::PathBuf;
     let mut cmd = bin();
     cmd.env("NC_OTLP_ENDPOINT", "http://localhost:4317");
-    cmd.args(&[
+    cmd.args([
         "lower",
         "--pipeline", "validate",
         "--dump-dir", "target/test-dumps-otlp",
@@ -131,6 +131,83 @@ pub fn parse_target_manifest_path<P: AsRef<Path>>(path: P) -> Result<TargetManif
     parse_target_manifest_str(&data)
 }
 
+/// Embedded copies of the `targets/*.toml` manifest stubs for every
+/// [`builtin_targets`] entry, so hermetic deployments resolve targets
+/// without touching the filesystem.
+static BUILTIN_MANIFEST_TOML: &[(&str, &str)] = &[
+    ("loihi2", include_str!("../../../targets/loihi2.toml")),
+    ("truenorth", include_str!("../../../targets/truenorth.toml")),
+    ("akida", include_str!("../../../targets/akida.toml")),
+    ("spinnaker2", include_str!("../../../targets/spinnaker2.toml")),
+    ("neurogrid", include_str!("../../../targets/neurogrid.toml")),
+    ("dynaps", include_str!("../../../targets/dynaps.toml")),
+    ("memxbar", include_str!("../../../targets/memxbar.toml")),
+    ("custom_asic", include_str!("../../../targets/custom_asic.toml")),
+    ("riscv64gcv_linux", include_str!("../../../targets/riscv64gcv_linux.toml")),
+    ("riscv32imac_bare", include_str!("../../../targets/riscv32imac_bare.toml")),
+    ("riscv64gc_ctrl", include_str!("../../../targets/riscv64gc_ctrl.toml")),
+];
+
+/// Process-wide manifest store: each manifest is parsed and validated once,
+/// then shared. Keyed by canonical path for files; builtins by name.
+static MANIFEST_STORE: std::sync::OnceLock<
+    std::sync::Mutex<std::collections::HashMap<PathBuf, std::sync::Arc<TargetManifest>>>,
+> = std::sync::OnceLock::new();
+static BUILTIN_STORE: std::sync::OnceLock<
+    std::sync::Mutex<std::collections::HashMap<&'static str, std::sync::Arc<TargetManifest>>>,
+> = std::sync::OnceLock::new();
+
+/// Parsed and validated embedded manifest for a builtin target name, cached
+/// per process. Returns `None` for unknown names.
+pub fn builtin_manifest(name: &str) -> Option<std::sync::Arc<TargetManifest>> {
+    let (key, toml_src) = BUILTIN_MANIFEST_TOML.iter().find(|(n, _)| *n == name)?;
+    let mut map = BUILTIN_STORE
+        .get_or_init(Default::default)
+        .lock()
+        .expect("builtin manifest store poisoned");
+    if let Some(m) = map.get(key) {
+        return Some(m.clone());
+    }
+    let m = parse_target_manifest_str(toml_src).ok()?;
+    validate_manifest(&m).ok()?;
+    let arc = std::sync::Arc::new(m);
+    map.insert(key, arc.clone());
+    Some(arc)
+}
+
+/// Load, validate, and cache the manifest at `path`; later lookups for the
+/// same file share the cached copy instead of re-reading and re-parsing the
+/// TOML. When the file does not exist but its stem names a builtin target,
+/// the embedded manifest is used, so compiles work without a `targets/` dir.
+pub fn manifest_for_path<P: AsRef<Path>>(path: P) -> Result<std::sync::Arc<TargetManifest>, anyhow::Error> {
+    let path = path.as_ref();
+    let key = fs::canonicalize(path).unwrap_or_else(|_| path.to_path_buf());
+    {
+        let map = MANIFEST_STORE
+            .get_or_init(Default::default)
+            .lock()
+            .expect("manifest store poisoned");
+        if let Some(m) = map.get(&key) {
+            return Ok(m.clone());
+        }
+    }
+    let m = if path.exists() {
+        let m = parse_target_manifest_path(path)?;
+        validate_manifest(&m)?;
+        std::sync::Arc::new(m)
+    } else {
+        let stem = path.file_stem().and_then(|s| s.to_str()).unwrap_or_default();
+        builtin_manifest(stem)
+            .ok_or_else(|| anyhow::anyhow!("manifest not found: {path:?} (no builtin target '{stem}')"))?
+    };
+    MANIFEST_STORE
+        .get_or_init(Default::default)
+        .lock()
+        .expect("manifest store poisoned")
+        .insert(key, m.clone());
+    Ok(m)
+}
+
 pub fn load_manifests_from_dir<P: AsRef<Path>>(dir: P) -> Result<Vec<(PathBuf, TargetManifest)>, anyhow::Error> {
     let mut out = Vec::new();
     for entry in fs::read_dir(dir)? {
@@ -345,6 +422,32 @@ mod tests_builtin {
             super::validate_manifest(&m).expect("manifest valid");
         }
     }
+
+    #[test]
+    fn builtin_manifests_embedded_and_valid() {
+        for t in builtin_targets() {
+            let m = builtin_manifest(t).unwrap_or_else(|| panic!("builtin manifest '{t}' missing or invalid"));
+            assert_eq!(&m.name, t, "embedded manifest name mismatch for '{t}'");
+        }
+        assert!(builtin_manifest("no-such-target").is_none());
+    }
+
+    #[test]
+    fn manifest_store_shares_one_parse_per_path() {
+        let crate_dir = PathBuf::from(env!("CARGO_MANIFEST_DIR"));
+        let ws_root = crate_dir.parent().and_then(|p| p.parent()).expect("workspace root");
+        let path = ws_root.join("targets").join("loihi2.toml");
+        let a = manifest_for_path(&path).expect("load loihi2 manifest");
+        let b = manifest_for_path(&path).expect("cached loihi2 manifest");
+        assert!(std::sync::Arc::ptr_eq(&a, &b), "second lookup should share the cached manifest");
+    }
+
+    #[test]
+    fn manifest_store_falls_back_to_builtin_for_missing_file() {
+        let m = manifest_for_path("no-such-dir/truenorth.toml").expect("builtin fallback");
+        assert_eq!(m.name, "truenorth");
+        assert!(manifest_for_path("no-such-dir/unknown.toml").is_err());
+    }
 }
 
 #[cfg(test)]
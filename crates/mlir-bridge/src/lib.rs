@@ -1,30 +1,96 @@
 use anyhow::{bail, Result};
+use std::io::Write;
 
 /// Build-time feature gate check for MLIR integration.
 pub fn is_enabled() -> bool { cfg!(feature = "mlir") }
 
-/// Lower a NIR graph to a minimal textual MLIR-like representation.
-/// Minimal emitter for core subset: populations and connections.
-pub fn lower_to_mlir(g: &nc_nir::Graph) -> Result<String> {
+/// Magic + format version for the compact bytecode form.
+const BYTECODE_MAGIC: &[u8; 4] = b"NCMB";
+const BYTECODE_VERSION: u32 = 1;
+
+/// Lower a NIR graph to a minimal textual MLIR-like representation, streaming
+/// into `w`. One op per population and per connection is written directly to
+/// the writer, so the whole module is never materialized in memory; callers
+/// should hand in a buffered writer for file output.
+pub fn lower_to_mlir_writer<W: Write + ?Sized>(g: &nc_nir::Graph, w: &mut W) -> Result<()> {
     if !is_enabled() {
         bail!("mlir feature is disabled; build with feature 'mlir'");
     }
-    let mut out = String::new();
-    out.push_str(&format!("module @{} attributes {{nir_version = \"{}\"}} {{\n", g.name, nc_nir::VERSION));
+    writeln!(w, "module @{} attributes {{nir_version = \"{}\"}} {{", g.name, nc_nir::VERSION)?;
     for p in &g.populations {
-        out.push_str(&format!(
-            "  %{} = \"nir.population\"() {{name = \"{}\", size = {}}} : () -> none\n",
+        writeln!(
+            w,
+            "  %{} = \"nir.population\"() {{name = \"{}\", size = {}}} : () -> none",
             p.name, p.name, p.size
-        ));
+        )?;
     }
     for c in &g.connections {
-        out.push_str(&format!(
-            "  \"nir.connect\"() {{pre = \"{}\", post = \"{}\", weight = {:.6}, delay_ms = {:.6}}} : () -> none\n",
+        writeln!(
+            w,
+            "  \"nir.connect\"() {{pre = \"{}\", post = \"{}\", weight = {:.6}, delay_ms = {:.6}}} : () -> none",
             c.pre, c.post, c.weight, c.delay_ms
-        ));
+        )?;
     }
-    out.push_str("}\n");
-    Ok(out)
+    writeln!(w, "}}")?;
+    Ok(())
+}
+
+/// Lower a NIR graph to a minimal textual MLIR-like representation.
+/// Minimal emitter for core subset: populations and connections.
+/// Convenience wrapper over [`lower_to_mlir_writer`]; prefer the writer form
+/// for large graphs to avoid holding the whole module text in memory.
+pub fn lower_to_mlir(g: &nc_nir::Graph) -> Result<String> {
+    let mut out = Vec::new();
+    lower_to_mlir_writer(g, &mut out)?;
+    Ok(String::from_utf8(out).expect("emitter writes UTF-8"))
+}
+
+/// Compact binary encoding of the same module (little-endian, `NCMB` magic):
+/// an interned population table followed by connections as table indices, so
+/// downstream tooling skips text re-parsing. This is our own bytecode framing,
+/// not upstream MLIR bytecode.
+///
+/// Layout: magic, format version, nir version string, module name,
+/// `n_pops` × (name, size u32), `n_conns` × (pre u32, post u32, weight f32,
+/// delay_ms f32). Strings are u32-length-prefixed UTF-8. Connections whose
+/// endpoints are not in the population table are skipped, matching the
+/// textual form's best-effort handling of unvalidated graphs.
+pub fn lower_to_mlir_bytecode_writer<W: Write + ?Sized>(g: &nc_nir::Graph, w: &mut W) -> Result<()> {
+    if !is_enabled() {
+        bail!("mlir feature is disabled; build with feature 'mlir'");
+    }
+    let write_str = |w: &mut W, s: &str| -> Result<()> {
+        w.write_all(&(s.len() as u32).to_le_bytes())?;
+        w.write_all(s.as_bytes())?;
+        Ok(())
+    };
+    w.write_all(BYTECODE_MAGIC)?;
+    w.write_all(&BYTECODE_VERSION.to_le_bytes())?;
+    write_str(w, nc_nir::VERSION)?;
+    write_str(w, &g.name)?;
+
+    w.write_all(&(g.populations.len() as u32).to_le_bytes())?;
+    let mut index = std::collections::HashMap::with_capacity(g.populations.len());
+    for (i, p) in g.populations.iter().enumerate() {
+        index.insert(p.name.as_str(), i as u32);
+        write_str(w, &p.name)?;
+        w.write_all(&p.size.to_le_bytes())?;
+    }
+
+    let resolved: u32 = g.connections.iter()
+        .filter(|c| index.contains_key(c.pre.as_str()) && index.contains_key(c.post.as_str()))
+        .count() as u32;
+    w.write_all(&resolved.to_le_bytes())?;
+    for c in &g.connections {
+        let (Some(pre), Some(post)) = (index.get(c.pre.as_str()), index.get(c.post.as_str())) else {
+            continue;
+        };
+        w.write_all(&pre.to_le_bytes())?;
+        w.write_all(&post.to_le_bytes())?;
+        w.write_all(&c.weight.to_le_bytes())?;
+        w.write_all(&c.delay_ms.to_le_bytes())?;
+    }
+    Ok(())
 }
 
 #[cfg(test)]
@@ -50,4 +116,26 @@ mod tests {
         assert!(s.contains("module @t"));
         assert!(s.contains("nir.population"));
     }
+
+    #[cfg(feature = "mlir")]
+    #[test]
+    fn writer_form_matches_string_form() {
+        let g = nc_nir::fixtures::chain(&[4, 8]);
+        let mut buf = Vec::new();
+        lower_to_mlir_writer(&g, &mut buf).unwrap();
+        assert_eq!(String::from_utf8(buf).unwrap(), lower_to_mlir(&g).unwrap());
+    }
+
+    #[cfg(feature = "mlir")]
+    #[test]
+    fn bytecode_is_compact_and_framed() {
+        let g = nc_nir::fixtures::chain(&[4, 8, 16]);
+        let mut bin = Vec::new();
+        lower_to_mlir_bytecode_writer(&g, &mut bin).unwrap();
+        assert_eq!(&bin[..4], BYTECODE_MAGIC);
+        assert!(bin.len() < lower_to_mlir(&g).unwrap().len(), "bytecode should be smaller than text");
+        // 2 resolved connections at 16 bytes each sit at the tail
+        let n_conns = u32::from_le_bytes(bin[bin.len() - 2 * 16 - 4..bin.len() - 2 * 16].try_into().unwrap());
+        assert_eq!(n_conns, 2);
+    }
 }
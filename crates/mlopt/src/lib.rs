@@ -48,11 +48,306 @@ impl CostModel for NoOpCostModel {
     }
 }
 
+/// Analytical cost model driven by `nc_hal::Capabilities` and a
+/// `PartitionPlan`: per-part compute time from neuron counts and tick rate,
+/// cross-part communication time from event rates, `bytes_per_event`, and
+/// interconnect bandwidth. Per-population and per-edge terms are memoized per
+/// graph, so re-scoring candidate assignments during mapping search only
+/// re-aggregates cached terms instead of re-walking the graph.
+pub struct HalCostModel {
+    caps: nc_hal::Capabilities,
+    plan: nc_orchestrator::PartitionPlan,
+    memo: std::sync::Mutex<Option<std::sync::Arc<CostMemo>>>,
+}
+
+/// Latency/energy estimate split into its components.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct CostBreakdown {
+    /// Busiest part's neuron-update time per model second.
+    pub compute_ms: f64,
+    /// Cross-part event transfer time per model second.
+    pub comm_ms: f64,
+    /// compute_ms + comm_ms.
+    pub latency_ms: f64,
+    pub energy_mj: f64,
+}
+
+/// Graph-derived terms that do not depend on the assignment.
+struct CostMemo {
+    /// Adjacency index the terms were computed from. Its identity keys the
+    /// memo: topology edits drop the graph's cached index (see
+    /// `Graph::invalidate_adjacency`), so a stale entry can never match. The
+    /// weak handle guards against a later allocation reusing the address.
+    adj: std::sync::Weak<nc_nir::AdjacencyIndex>,
+    /// Per-population neuron-update time (ms per model second).
+    pop_compute_ms: Vec<f64>,
+    /// Per-population update energy (mJ per model second).
+    pop_update_mj: Vec<f64>,
+    /// (pre, post, bytes/s, mJ/s) for every resolved connection.
+    edges: Vec<(u32, u32, f64, f64)>,
+}
+
+// Nominal constants for quantities no manifest field describes yet; they set
+// the scale, the capability fields set the shape.
+const NEURON_UPDATE_NS: f64 = 5.0;
+const UPDATE_ENERGY_NJ: f64 = 0.5;
+const EVENT_ENERGY_NJ: f64 = 2.0;
+// Fallbacks for absent capability fields.
+const DEFAULT_BYTES_PER_EVENT: f64 = 8.0;
+const DEFAULT_SPIKE_RATE_HZ: f64 = 10.0;
+const DEFAULT_BANDWIDTH_MBPS: f64 = 1_000.0;
+const DEFAULT_TIME_RESOLUTION_NS: f64 = 1_000_000.0;
+
+impl HalCostModel {
+    pub fn new(caps: nc_hal::Capabilities, plan: nc_orchestrator::PartitionPlan) -> Self {
+        Self { caps, plan, memo: std::sync::Mutex::new(None) }
+    }
+
+    fn memo(&self, g: &nc_nir::Graph) -> std::sync::Arc<CostMemo> {
+        let adj = g.adjacency();
+        let mut slot = self.memo.lock().expect("cost memo lock");
+        if let Some(m) = slot.as_ref() {
+            if m.adj.upgrade().is_some_and(|a| std::sync::Arc::ptr_eq(&a, &adj)) {
+                return m.clone();
+            }
+        }
+
+        let ticks_per_s =
+            1e9 / self.caps.time_resolution_ns.map(|v| v as f64).unwrap_or(DEFAULT_TIME_RESOLUTION_NS);
+        let rate_hz = self.caps.default_spike_rate_hz.unwrap_or(DEFAULT_SPIKE_RATE_HZ);
+        let bytes_per_event =
+            self.caps.bytes_per_event.map(f64::from).unwrap_or(DEFAULT_BYTES_PER_EVENT);
+
+        let mut pop_compute_ms = Vec::with_capacity(g.populations.len());
+        let mut pop_update_mj = Vec::with_capacity(g.populations.len());
+        for p in &g.populations {
+            let updates_per_s = p.size as f64 * ticks_per_s;
+            pop_compute_ms.push(updates_per_s * NEURON_UPDATE_NS * 1e-6);
+            pop_update_mj.push(updates_per_s * UPDATE_ENERGY_NJ * 1e-6);
+        }
+
+        let mut edges = Vec::with_capacity(g.connections.len());
+        for pre in 0..adj.num_populations() as u32 {
+            let events_per_s = g.populations[pre as usize].size as f64 * rate_hz;
+            for &post in adj.out_edges(pre) {
+                if post == u32::MAX {
+                    continue;
+                }
+                edges.push((
+                    pre,
+                    post,
+                    events_per_s * bytes_per_event,
+                    events_per_s * EVENT_ENERGY_NJ * 1e-6,
+                ));
+            }
+        }
+
+        let m = std::sync::Arc::new(CostMemo {
+            adj: std::sync::Arc::downgrade(&adj),
+            pop_compute_ms,
+            pop_update_mj,
+            edges,
+        });
+        *slot = Some(m.clone());
+        m
+    }
+
+    /// Map the plan's assignment onto population indices; populations the
+    /// plan does not mention land in part 0.
+    fn part_of(&self, g: &nc_nir::Graph) -> (Vec<usize>, usize) {
+        let parts = self.plan.parts.max(1);
+        let mut part_of = vec![0usize; g.populations.len()];
+        if !self.plan.assignment.is_empty() {
+            let adj = g.adjacency();
+            for (name, part) in &self.plan.assignment {
+                if let Some(id) = adj.id_of(name) {
+                    part_of[id as usize] = (*part).min(parts - 1);
+                }
+            }
+        }
+        (part_of, parts)
+    }
+
+    /// Score an explicit assignment using the memoized per-population and
+    /// per-edge terms; O(P + E) with no string handling or graph walk.
+    pub fn score_assignment(
+        &self,
+        g: &nc_nir::Graph,
+        part_of: &[usize],
+        parts: usize,
+    ) -> CostBreakdown {
+        let m = self.memo(g);
+        let mut compute = vec![0f64; parts.max(1)];
+        let mut energy = 0f64;
+        for (i, &p) in part_of.iter().enumerate() {
+            compute[p] += m.pop_compute_ms[i];
+            energy += m.pop_update_mj[i];
+        }
+        let mut cross_bytes = 0f64;
+        for &(pre, post, bytes, mj) in &m.edges {
+            energy += mj;
+            if part_of[pre as usize] != part_of[post as usize] {
+                cross_bytes += bytes;
+            }
+        }
+        let bandwidth_bytes_per_ms = self
+            .caps
+            .interconnect_bandwidth_mbps
+            .map(f64::from)
+            .unwrap_or(DEFAULT_BANDWIDTH_MBPS)
+            * 125_000.0
+            / 1_000.0;
+        let compute_ms = compute.iter().cloned().fold(0f64, f64::max);
+        let comm_ms = cross_bytes / bandwidth_bytes_per_ms;
+        CostBreakdown {
+            compute_ms,
+            comm_ms,
+            latency_ms: compute_ms + comm_ms,
+            energy_mj: energy,
+        }
+    }
+
+    pub fn predict(&self, g: &nc_nir::Graph) -> CostBreakdown {
+        let (part_of, parts) = self.part_of(g);
+        self.score_assignment(g, &part_of, parts)
+    }
+}
+
+impl CostModel for HalCostModel {
+    fn predict_latency_ms(&self, graph: &nc_nir::Graph) -> Result<f64> {
+        Ok(self.predict(graph).latency_ms)
+    }
+    fn predict_energy_mj(&self, graph: &nc_nir::Graph) -> Result<f64> {
+        Ok(self.predict(graph).energy_mj)
+    }
+}
+
 pub trait MappingSearch {
     fn propose(&mut self, graph: &nc_nir::Graph) -> Result<String>;
     fn feedback(&mut self, score: f64);
 }
 
+/// Simulated-annealing search over partition assignments, scored against the
+/// memoized [`HalCostModel`]. Each generation mutates the incumbent into a
+/// batch of candidates and scores them concurrently on scoped threads; the
+/// best candidate is accepted greedily or, with a temperature-decayed
+/// probability, even when worse. Deterministic for a given seed.
+pub struct AnnealingSearch {
+    caps: nc_hal::Capabilities,
+    parts: usize,
+    seed: u64,
+    /// Annealing generations per `propose` call.
+    pub generations: usize,
+    /// Candidates mutated and scored per generation.
+    pub batch: usize,
+    last_score: Option<f64>,
+}
+
+impl AnnealingSearch {
+    pub fn new(caps: nc_hal::Capabilities, parts: usize, seed: u64) -> Self {
+        Self { caps, parts, seed, generations: 32, batch: 16, last_score: None }
+    }
+
+    /// Score one assignment; factored out so candidates can borrow the model
+    /// from scoped threads.
+    fn score(model: &HalCostModel, g: &nc_nir::Graph, cand: &[usize], parts: usize) -> f64 {
+        model.score_assignment(g, cand, parts).latency_ms
+    }
+}
+
+impl MappingSearch for AnnealingSearch {
+    fn propose(&mut self, graph: &nc_nir::Graph) -> Result<String> {
+        let n = graph.populations.len();
+        let parts = self.parts.max(1);
+        let mut rng = nc_nir::generate::Rng::new(self.seed);
+        let plan = nc_orchestrator::PartitionPlan { parts, assignment: Vec::new() };
+        let model = HalCostModel::new(self.caps.clone(), plan);
+
+        // Index-chunked incumbent; the search only has to beat it.
+        let chunk = n.div_ceil(parts).max(1);
+        let mut current: Vec<usize> = (0..n).map(|i| i / chunk).collect();
+        let mut current_cost = Self::score(&model, graph, &current, parts);
+        let mut best = current.clone();
+        let mut best_cost = current_cost;
+
+        let threads = std::thread::available_parallelism().map(|v| v.get()).unwrap_or(1);
+        let t0 = (current_cost / 10.0).max(f64::MIN_POSITIVE);
+        for gen in 0..self.generations {
+            if n == 0 || parts == 1 {
+                break;
+            }
+            // Batch of mutations: move 1-3 random populations to random parts.
+            let candidates: Vec<Vec<usize>> = (0..self.batch)
+                .map(|_| {
+                    let mut c = current.clone();
+                    let moves = 1 + (rng.next_u64() % 3) as usize;
+                    for _ in 0..moves {
+                        let i = (rng.next_u64() % n as u64) as usize;
+                        c[i] = (rng.next_u64() % parts as u64) as usize;
+                    }
+                    c
+                })
+                .collect();
+            let mut scores = vec![0f64; candidates.len()];
+            let chunk_len = candidates.len().div_ceil(threads.min(candidates.len()).max(1));
+            std::thread::scope(|s| {
+                for (cands, outs) in
+                    candidates.chunks(chunk_len).zip(scores.chunks_mut(chunk_len))
+                {
+                    let model = &model;
+                    s.spawn(move || {
+                        for (c, o) in cands.iter().zip(outs.iter_mut()) {
+                            *o = Self::score(model, graph, c, parts);
+                        }
+                    });
+                }
+            });
+
+            let (idx, &cost) = scores
+                .iter()
+                .enumerate()
+                .min_by(|a, b| a.1.total_cmp(b.1))
+                .expect("non-empty batch");
+            let temperature = t0 * 0.9f64.powi(gen as i32);
+            let accept = cost < current_cost || {
+                let u = (rng.next_u64() >> 11) as f64 / (1u64 << 53) as f64;
+                u < (-(cost - current_cost) / temperature).exp()
+            };
+            if accept {
+                current = candidates[idx].clone();
+                current_cost = cost;
+            }
+            if cost < best_cost {
+                best = candidates[idx].clone();
+                best_cost = cost;
+            }
+        }
+
+        let assignment: Vec<serde_json::Value> = graph
+            .populations
+            .iter()
+            .enumerate()
+            .map(|(i, p)| serde_json::json!({ "population": p.name, "part": best[i] }))
+            .collect();
+        Ok(serde_json::json!({
+            "parts": parts,
+            "assignment": assignment,
+            "predicted_latency_ms": best_cost,
+        })
+        .to_string())
+    }
+
+    fn feedback(&mut self, score: f64) {
+        #[cfg(feature = "telemetry")]
+        if let Ok(p) = std::env::var("NC_PROFILE_JSONL") {
+            if let Ok(a) = telemetry::profiling::Appender::open(p) {
+                let _ = a.counter("mlopt.search.feedback", score, BTreeMap::new());
+            }
+        }
+        self.last_score = Some(score);
+    }
+}
+
 #[derive(Default)]
 pub struct GreedySearchStub {
     last_score: Option<f64>,
@@ -101,6 +396,143 @@ mod tests {
         assert_eq!(cm.predict_energy_mj(&g).unwrap(), 0.0);
     }
 
+    fn caps() -> nc_hal::Capabilities {
+        serde_json::from_value(serde_json::json!({
+            "bytes_per_event": 8,
+            "default_spike_rate_hz": 100.0,
+            "interconnect_bandwidth_mbps": 100,
+            "time_resolution_ns": 1000000u64
+        }))
+        .unwrap()
+    }
+
+    #[test]
+    fn hal_cost_model_scales_with_graph_size() {
+        let small = nc_nir::fixtures::chain(&[16, 16]);
+        let large = nc_nir::fixtures::chain(&[1024, 1024]);
+        let plan = nc_orchestrator::PartitionPlan { parts: 1, assignment: Vec::new() };
+        let cm = HalCostModel::new(caps(), plan.clone());
+        let l_small = cm.predict_latency_ms(&small).unwrap();
+        let cm = HalCostModel::new(caps(), plan);
+        let l_large = cm.predict_latency_ms(&large).unwrap();
+        assert!(l_small > 0.0);
+        assert!(l_large > l_small);
+    }
+
+    #[test]
+    fn cross_part_cut_adds_comm_time() {
+        let g = nc_nir::fixtures::chain(&[256, 256, 256]);
+        let together = nc_orchestrator::PartitionPlan {
+            parts: 2,
+            assignment: vec![("p0".into(), 0), ("p1".into(), 0), ("p2".into(), 0)],
+        };
+        let split = nc_orchestrator::PartitionPlan {
+            parts: 2,
+            assignment: vec![("p0".into(), 0), ("p1".into(), 1), ("p2".into(), 0)],
+        };
+        let a = HalCostModel::new(caps(), together).predict(&g);
+        let b = HalCostModel::new(caps(), split).predict(&g);
+        assert_eq!(a.comm_ms, 0.0);
+        assert!(b.comm_ms > 0.0);
+        // Splitting spreads compute but pays for every crossing edge.
+        assert!(b.latency_ms > 0.0 && a.energy_mj == b.energy_mj);
+    }
+
+    #[test]
+    fn memoized_terms_give_stable_predictions() {
+        let g = nc_nir::fixtures::star(64, 16, 8, 0.5, 1.0);
+        let plan = nc_orchestrator::PartitionPlan { parts: 1, assignment: Vec::new() };
+        let cm = HalCostModel::new(caps(), plan);
+        let first = cm.predict(&g);
+        let second = cm.predict(&g);
+        assert_eq!(first, second);
+    }
+
+    #[test]
+    fn count_preserving_edit_invalidates_memo() {
+        let mut g = nc_nir::fixtures::star(64, 16, 8, 0.5, 1.0);
+        let plan = nc_orchestrator::PartitionPlan { parts: 1, assignment: Vec::new() };
+        let cm = HalCostModel::new(caps(), plan);
+        let before = cm.predict(&g);
+        // Resizing keeps population/connection counts; the dropped adjacency
+        // cache is what must force the terms to be recomputed.
+        g.populations[0].size *= 4;
+        g.invalidate_adjacency();
+        let after = cm.predict(&g);
+        assert!(after.latency_ms > before.latency_ms);
+    }
+
+    /// Interleaved clusters: index chunking splits both apart, so the search
+    /// has an easy win to find.
+    fn interleaved_clusters() -> nc_nir::Graph {
+        let mut g = nc_nir::Graph::new("interleaved");
+        for i in 0..4 {
+            for prefix in ["c", "d"] {
+                g.populations.push(nc_nir::Population {
+                    name: format!("{prefix}{i}"),
+                    size: 32,
+                    model: "lif".into(),
+                    params: serde_json::json!({}),
+                });
+            }
+        }
+        for i in 0..4 {
+            for j in 0..4 {
+                if i != j {
+                    g.connections.push(nc_nir::Connection {
+                        pre: format!("c{i}"),
+                        post: format!("c{j}"),
+                        weight: 0.5,
+                        delay_ms: 1.0,
+                        plasticity: None,
+                        synapses: None,
+                    });
+                    g.connections.push(nc_nir::Connection {
+                        pre: format!("d{i}"),
+                        post: format!("d{j}"),
+                        weight: 0.5,
+                        delay_ms: 1.0,
+                        plasticity: None,
+                        synapses: None,
+                    });
+                }
+            }
+        }
+        g
+    }
+
+    #[test]
+    fn annealing_beats_index_chunking_on_interleaved_clusters() {
+        let g = interleaved_clusters();
+        let parts = 2;
+        let mut s = AnnealingSearch::new(caps(), parts, 7);
+        let proposal: serde_json::Value =
+            serde_json::from_str(&s.propose(&g).unwrap()).unwrap();
+        let assignment: Vec<usize> = proposal["assignment"]
+            .as_array()
+            .unwrap()
+            .iter()
+            .map(|e| e["part"].as_u64().unwrap() as usize)
+            .collect();
+        assert_eq!(assignment.len(), g.populations.len());
+
+        let plan = nc_orchestrator::PartitionPlan { parts, assignment: Vec::new() };
+        let model = HalCostModel::new(caps(), plan);
+        let chunk = g.populations.len().div_ceil(parts);
+        let chunked: Vec<usize> = (0..g.populations.len()).map(|i| i / chunk).collect();
+        let found = model.score_assignment(&g, &assignment, parts).latency_ms;
+        let baseline = model.score_assignment(&g, &chunked, parts).latency_ms;
+        assert!(found < baseline, "search {found} should beat chunking {baseline}");
+    }
+
+    #[test]
+    fn annealing_deterministic_for_seed() {
+        let g = interleaved_clusters();
+        let p1 = AnnealingSearch::new(caps(), 2, 42).propose(&g).unwrap();
+        let p2 = AnnealingSearch::new(caps(), 2, 42).propose(&g).unwrap();
+        assert_eq!(p1, p2);
+    }
+
     #[test]
     fn search_stub() {
         let mut s = GreedySearchStub::new();
@@ -0,0 +1,53 @@
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use nc_nir::Graph;
+
+fn xorshift64(state: &mut u64) -> u64 {
+    let mut x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    x
+}
+
+/// Connection-only graph: bincode is not self-describing and cannot decode
+/// the free-form `params`/`attributes` JSON values, so the binary benchmark
+/// measures the connection plane, which dominates payload size anyway.
+fn synth_connections(edges: usize, seed: u64) -> Graph {
+    let pops = std::cmp::max(edges / 64, 2);
+    let mut g = Graph::new(format!("synth_bin_{edges}"));
+    let mut s = seed | 1;
+    for _ in 0..edges {
+        let pre = (xorshift64(&mut s) % pops as u64) as usize;
+        let post = (xorshift64(&mut s) % pops as u64) as usize;
+        g.connections.push(nc_nir::Connection {
+            pre: format!("p{pre}"),
+            post: format!("p{post}"),
+            weight: 0.5,
+            delay_ms: 1.0,
+            plasticity: None,
+            synapses: None,
+        });
+    }
+    g
+}
+
+fn bench_parse_bincode(c: &mut Criterion) {
+    let mut group = c.benchmark_group("nir_parse/bincode");
+    group.sample_size(10);
+    for &edges in &[10_000usize, 100_000, 1_000_000] {
+        let bytes = synth_connections(edges, 0xC0FFEE).to_bytes().unwrap();
+        group.throughput(Throughput::Bytes(bytes.len() as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(edges), &bytes, |b, bytes| {
+            b.iter(|| black_box(Graph::from_bytes(black_box(bytes)).unwrap()))
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(
+    name = bin_parse_benches;
+    config = Criterion::default();
+    targets = bench_parse_bincode
+);
+criterion_main!(bin_parse_benches);
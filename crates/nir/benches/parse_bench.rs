@@ -0,0 +1,47 @@
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use nc_nir::{generate, Graph};
+
+/// Uniform-degree synthetic graph with roughly `edges` connections.
+fn synth_graph(edges: usize) -> Graph {
+    let cfg = generate::GeneratorConfig {
+        populations: std::cmp::max(edges / 64, 2) as u32,
+        degree: generate::DegreeDistribution::Uniform { out_degree: 64 },
+        ..Default::default()
+    };
+    generate::build(&cfg)
+}
+
+fn bench_parse_json(c: &mut Criterion) {
+    let mut group = c.benchmark_group("nir_parse/json");
+    group.sample_size(10);
+    for &edges in &[10_000usize, 100_000, 1_000_000] {
+        let s = synth_graph(edges).to_json_string().unwrap();
+        group.throughput(Throughput::Bytes(s.len() as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(edges), &s, |b, s| {
+            b.iter(|| black_box(Graph::from_json_str(black_box(s)).unwrap()))
+        });
+    }
+    group.finish();
+}
+
+fn bench_parse_yaml(c: &mut Criterion) {
+    let mut group = c.benchmark_group("nir_parse/yaml");
+    group.sample_size(10);
+    // YAML stops at 100k edges: serde_yaml is roughly an order of magnitude
+    // slower than JSON and the 1M point takes minutes per sample.
+    for &edges in &[10_000usize, 100_000] {
+        let s = synth_graph(edges).to_yaml_string().unwrap();
+        group.throughput(Throughput::Bytes(s.len() as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(edges), &s, |b, s| {
+            b.iter(|| black_box(Graph::from_yaml_str(black_box(s)).unwrap()))
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(
+    name = parse_benches;
+    config = Criterion::default();
+    targets = bench_parse_json, bench_parse_yaml
+);
+criterion_main!(parse_benches);
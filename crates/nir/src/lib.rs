@@ -1,6 +1,5 @@
 use indexmap::IndexMap;
 use serde::{Deserialize, Serialize};
-use std::collections::HashSet;
 
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct Population {
@@ -21,6 +20,65 @@ pub struct Connection {
     pub delay_ms: f32,
     #[serde(default)]
     pub plasticity: Option<PlasticityRule>,
+    /// Optional synapse-level expansion; when absent, `weight` is the
+    /// population-to-population scalar as before.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub synapses: Option<SynapseMatrix>,
+}
+
+/// Synapse-level sparse connectivity for one connection, stored CSR over the
+/// pre-population's neurons: `row_ptr` has `pre_size + 1` entries, and
+/// `col_idx`/`weights` are parallel planes of length nnz (post-neuron index
+/// and synaptic weight). Weights live in one contiguous `Vec<f32>` so
+/// quantization, scaling, and precision conversion run over flat slices and
+/// backends can copy the plane straight into device layouts.
+#[derive(Debug, Clone, Default, Serialize, Deserialize)]
+pub struct SynapseMatrix {
+    pub row_ptr: Vec<u32>,
+    pub col_idx: Vec<u32>,
+    pub weights: Vec<f32>,
+}
+
+impl SynapseMatrix {
+    /// Number of synapses (non-zeros).
+    pub fn nnz(&self) -> usize {
+        self.weights.len()
+    }
+
+    /// Synapse slots (into `col_idx`/`weights`) for one pre-neuron row.
+    pub fn row(&self, pre_neuron: u32) -> std::ops::Range<usize> {
+        self.row_ptr[pre_neuron as usize] as usize..self.row_ptr[pre_neuron as usize + 1] as usize
+    }
+
+    /// Structural consistency against the sizes of the two endpoint populations.
+    pub fn check_dims(&self, pre_size: u32, post_size: u32) -> Result<(), String> {
+        if self.row_ptr.len() != pre_size as usize + 1 {
+            return Err(format!(
+                "row_ptr has {} entries, expected pre_size + 1 = {}",
+                self.row_ptr.len(),
+                pre_size + 1
+            ));
+        }
+        if self.row_ptr.first() != Some(&0) {
+            return Err("row_ptr must start at 0".into());
+        }
+        if self.row_ptr.windows(2).any(|w| w[0] > w[1]) {
+            return Err("row_ptr must be non-decreasing".into());
+        }
+        let nnz = *self.row_ptr.last().expect("row_ptr non-empty") as usize;
+        if self.col_idx.len() != nnz || self.weights.len() != nnz {
+            return Err(format!(
+                "col_idx/weights have {}/{} entries, row_ptr implies {}",
+                self.col_idx.len(),
+                self.weights.len(),
+                nnz
+            ));
+        }
+        if let Some(&bad) = self.col_idx.iter().find(|&&c| c >= post_size) {
+            return Err(format!("col_idx {} out of range for post_size {}", bad, post_size));
+        }
+        Ok(())
+    }
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize)]
@@ -61,7 +119,57 @@ impl std::fmt::Display for ValidationError {
 
 impl std::error::Error for ValidationError {}
 
-#[derive(Debug, Clone, Serialize, Deserialize)]
+/// Typed, in-memory metadata for the well-known pass outputs.
+///
+/// Passes historically communicated only through [`Graph::attributes`], so
+/// every producer built a `serde_json::Value` tree per run and every consumer
+/// re-navigated it with chained string lookups. The side-table keeps those hot
+/// outputs as plain structs with O(1) field access; the JSON attribute remains
+/// the serialized form (dumps, stage cache, cross-process handoff), so the
+/// table is `serde(skip)` and consumers keep a JSON fallback for graphs that
+/// round-tripped through disk.
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct PassMeta {
+    pub rv_layout: Option<RvLayout>,
+    pub rv_schedule: Option<RvSchedule>,
+    pub rv_vectorize: Option<RvVectorize>,
+    pub partition: Option<PartitionAssignment>,
+}
+
+/// Output of the RISC-V layout pass (`rv_layout` attribute).
+#[derive(Debug, Clone, PartialEq)]
+pub struct RvLayout {
+    pub align_bytes: u64,
+    pub vector_available: bool,
+    pub vector_bytes: u64,
+    pub quant_bits_default: u64,
+}
+
+/// Output of the RISC-V schedule pass (`rv_schedule` attribute).
+/// `assignment` pairs are `(population, thread)`.
+#[derive(Debug, Clone, PartialEq)]
+pub struct RvSchedule {
+    pub threads: u64,
+    pub fused_stages: Vec<String>,
+    pub assignment: Vec<(String, u64)>,
+}
+
+/// Output of the RISC-V vectorize pass (`rv_vectorize` attribute).
+#[derive(Debug, Clone, PartialEq)]
+pub struct RvVectorize {
+    pub enabled: bool,
+    pub vlen_bytes: u64,
+}
+
+/// Output of the partition pass (`partition` attribute).
+/// `assignment` pairs are `(population, part)`.
+#[derive(Debug, Clone, PartialEq)]
+pub struct PartitionAssignment {
+    pub parts: u64,
+    pub assignment: Vec<(String, u64)>,
+}
+
+#[derive(Debug, Serialize, Deserialize)]
 pub struct Graph {
     pub name: String,
     #[serde(default)]
@@ -74,6 +182,148 @@ pub struct Graph {
     pub dialect: Option<Dialect>,
     #[serde(default)]
     pub attributes: IndexMap<String, serde_json::Value>,
+    /// Typed side-table for well-known pass outputs; see [`PassMeta`].
+    #[serde(skip)]
+    pub meta: PassMeta,
+    /// Lazily built adjacency index; see [`Graph::adjacency`].
+    #[serde(skip)]
+    adjacency_cache: std::sync::OnceLock<std::sync::Arc<AdjacencyIndex>>,
+}
+
+// Manual Clone: the adjacency cache describes this instance's topology, so a
+// clone (which may be mutated independently) starts with an empty cache.
+impl Clone for Graph {
+    fn clone(&self) -> Self {
+        Self {
+            name: self.name.clone(),
+            populations: self.populations.clone(),
+            connections: self.connections.clone(),
+            probes: self.probes.clone(),
+            dialect: self.dialect.clone(),
+            attributes: self.attributes.clone(),
+            meta: self.meta.clone(),
+            adjacency_cache: std::sync::OnceLock::new(),
+        }
+    }
+}
+
+/// Interned population IDs plus a CSR adjacency view over connections.
+///
+/// Populations get dense `u32` IDs in declaration order with a name table,
+/// so edge walks hash each name once at build time instead of once per edge.
+/// Out-edges are stored CSR-style (`row_ptr`/`col`), with a parallel array of
+/// connection indices so callers can get back to weights and delays.
+/// Structural problems (duplicate names, dangling endpoints) are recorded
+/// rather than rejected, which lets [`Graph::validate`] share the index.
+#[derive(Debug, Default)]
+pub struct AdjacencyIndex {
+    names: Vec<String>,
+    ids: std::collections::HashMap<String, u32>,
+    row_ptr: Vec<u32>,
+    col: Vec<u32>,
+    edge: Vec<u32>,
+    in_degree: Vec<u32>,
+    duplicate: Option<String>,
+    unresolved: Vec<usize>,
+}
+
+impl AdjacencyIndex {
+    fn build(g: &Graph) -> Self {
+        let n = g.populations.len();
+        let mut names = Vec::with_capacity(n);
+        let mut ids = std::collections::HashMap::with_capacity(n);
+        let mut duplicate = None;
+        for (i, p) in g.populations.iter().enumerate() {
+            if ids.insert(p.name.clone(), i as u32).is_some() && duplicate.is_none() {
+                duplicate = Some(p.name.clone());
+            }
+            names.push(p.name.clone());
+        }
+
+        // Resolve endpoints once per connection; count out-degrees for CSR.
+        let mut resolved: Vec<(u32, u32)> = Vec::with_capacity(g.connections.len());
+        let mut unresolved = Vec::new();
+        let mut out_deg = vec![0u32; n];
+        let mut in_degree = vec![0u32; n];
+        for (ci, c) in g.connections.iter().enumerate() {
+            match (ids.get(&c.pre), ids.get(&c.post)) {
+                (Some(&pre), Some(&post)) => {
+                    out_deg[pre as usize] += 1;
+                    in_degree[post as usize] += 1;
+                    resolved.push((pre, post));
+                }
+                _ => {
+                    unresolved.push(ci);
+                    resolved.push((u32::MAX, u32::MAX));
+                }
+            }
+        }
+
+        let mut row_ptr = vec![0u32; n + 1];
+        for i in 0..n {
+            row_ptr[i + 1] = row_ptr[i] + out_deg[i];
+        }
+        let nnz = row_ptr[n] as usize;
+        let mut col = vec![0u32; nnz];
+        let mut edge = vec![0u32; nnz];
+        let mut cursor: Vec<u32> = row_ptr[..n].to_vec();
+        for (ci, &(pre, post)) in resolved.iter().enumerate() {
+            if pre == u32::MAX {
+                continue;
+            }
+            let slot = cursor[pre as usize] as usize;
+            col[slot] = post;
+            edge[slot] = ci as u32;
+            cursor[pre as usize] += 1;
+        }
+
+        Self { names, ids, row_ptr, col, edge, in_degree, duplicate, unresolved }
+    }
+
+    /// Number of populations covered by the index.
+    pub fn num_populations(&self) -> usize {
+        self.names.len()
+    }
+
+    /// Dense ID for a population name, if it exists.
+    pub fn id_of(&self, name: &str) -> Option<u32> {
+        self.ids.get(name).copied()
+    }
+
+    /// Population name for a dense ID.
+    pub fn name_of(&self, id: u32) -> &str {
+        &self.names[id as usize]
+    }
+
+    /// Post-population IDs of out-edges from `id`.
+    pub fn out_edges(&self, id: u32) -> &[u32] {
+        let (a, b) = (self.row_ptr[id as usize] as usize, self.row_ptr[id as usize + 1] as usize);
+        &self.col[a..b]
+    }
+
+    /// Connection indices (into `Graph::connections`) of out-edges from `id`.
+    pub fn out_connections(&self, id: u32) -> &[u32] {
+        let (a, b) = (self.row_ptr[id as usize] as usize, self.row_ptr[id as usize + 1] as usize);
+        &self.edge[a..b]
+    }
+
+    pub fn out_degree(&self, id: u32) -> u32 {
+        self.row_ptr[id as usize + 1] - self.row_ptr[id as usize]
+    }
+
+    pub fn in_degree(&self, id: u32) -> u32 {
+        self.in_degree[id as usize]
+    }
+
+    /// First duplicated population name encountered, if any.
+    pub fn duplicate_population(&self) -> Option<&str> {
+        self.duplicate.as_deref()
+    }
+
+    /// Indices of connections whose pre or post population does not exist.
+    pub fn unresolved_connections(&self) -> &[usize] {
+        &self.unresolved
+    }
 }
 
 impl Graph {
@@ -85,9 +335,27 @@ impl Graph {
             probes: Vec::new(),
             dialect: None,
             attributes: IndexMap::new(),
+            meta: PassMeta::default(),
+            adjacency_cache: std::sync::OnceLock::new(),
         }
     }
 
+    /// Lazily built, cached adjacency index over the current topology.
+    ///
+    /// The cache is dropped on clone and by [`Graph::invalidate_adjacency`];
+    /// code that adds or removes populations/connections on a graph whose
+    /// index was already taken must invalidate before the next use.
+    pub fn adjacency(&self) -> std::sync::Arc<AdjacencyIndex> {
+        self.adjacency_cache
+            .get_or_init(|| std::sync::Arc::new(AdjacencyIndex::build(self)))
+            .clone()
+    }
+
+    /// Drop the cached adjacency index after a topology mutation.
+    pub fn invalidate_adjacency(&mut self) {
+        self.adjacency_cache = std::sync::OnceLock::new();
+    }
+
     pub fn to_json_string(&self) -> Result<String, serde_json::Error> {
         serde_json::to_string_pretty(self)
     }
@@ -111,20 +379,31 @@ impl Graph {
         bincode::deserialize(bytes)
     }
 
+    /// Write the graph as a sectioned binary container (see [`container`]).
+    #[cfg(feature = "bin")]
+    pub fn write_container(&self, path: impl AsRef<std::path::Path>) -> std::io::Result<()> {
+        container::write(self, path)
+    }
+
+    /// Open a sectioned binary container for lazy, per-section reads.
+    /// Only the header and section table are read here; populations,
+    /// connections, probes, and attributes decode on first access.
+    #[cfg(feature = "bin")]
+    pub fn open_container(path: impl AsRef<std::path::Path>) -> std::io::Result<container::Container> {
+        container::Container::open(path)
+    }
+
     /// Validate structural integrity of the graph.
     /// Checks:
     /// - population names unique and non-empty; size > 0; model non-empty
     /// - connections' pre/post exist; weight/delay finite; delay_ms >= 0
     /// - probes target an existing population; kind non-empty
     pub fn validate(&self) -> Result<(), ValidationError> {
-        let mut names: HashSet<String> = HashSet::new();
+        let adj = self.adjacency();
         for p in &self.populations {
             if p.name.trim().is_empty() {
                 return Err(ValidationError("population name cannot be empty".into()));
             }
-            if !names.insert(p.name.clone()) {
-                return Err(ValidationError(format!("duplicate population '{}'", p.name)));
-            }
             if p.size == 0 {
                 return Err(ValidationError(format!("population '{}' has size 0", p.name)));
             }
@@ -132,13 +411,17 @@ impl Graph {
                 return Err(ValidationError(format!("population '{}' missing model", p.name)));
             }
         }
-        for c in &self.connections {
-            if !names.contains(&c.pre) {
+        if let Some(dup) = adj.duplicate_population() {
+            return Err(ValidationError(format!("duplicate population '{}'", dup)));
+        }
+        if let Some(&ci) = adj.unresolved_connections().first() {
+            let c = &self.connections[ci];
+            if adj.id_of(&c.pre).is_none() {
                 return Err(ValidationError(format!("connection pre '{}' not found", c.pre)));
             }
-            if !names.contains(&c.post) {
-                return Err(ValidationError(format!("connection post '{}' not found", c.post)));
-            }
+            return Err(ValidationError(format!("connection post '{}' not found", c.post)));
+        }
+        for c in &self.connections {
             if !c.weight.is_finite() {
                 return Err(ValidationError(format!("connection {}->{} has non-finite weight", c.pre, c.post)));
             }
@@ -148,12 +431,25 @@ impl Graph {
                     c.pre, c.post, c.delay_ms
                 )));
             }
+            if let Some(m) = &c.synapses {
+                let pre_size = adj.id_of(&c.pre).map(|id| self.populations[id as usize].size).unwrap_or(0);
+                let post_size = adj.id_of(&c.post).map(|id| self.populations[id as usize].size).unwrap_or(0);
+                m.check_dims(pre_size, post_size).map_err(|e| {
+                    ValidationError(format!("connection {}->{} synapses: {}", c.pre, c.post, e))
+                })?;
+                if m.weights.iter().any(|w| !w.is_finite()) {
+                    return Err(ValidationError(format!(
+                        "connection {}->{} has non-finite synapse weight",
+                        c.pre, c.post
+                    )));
+                }
+            }
         }
         for pr in &self.probes {
             if pr.kind.trim().is_empty() {
                 return Err(ValidationError("probe kind cannot be empty".into()));
             }
-            if !names.contains(&pr.target) {
+            if adj.id_of(&pr.target).is_none() {
                 return Err(ValidationError(format!(
                     "probe target '{}' not found among populations",
                     pr.target
@@ -171,8 +467,640 @@ impl Graph {
     }
 }
 
+/// What a transformation touched, from a validation standpoint. Ordered by
+/// severity so a pipeline can fold several stages together with `max`.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord)]
+pub enum Mutation {
+    /// Only graph attributes changed; validation looks at none of them.
+    AttributesOnly,
+    /// Numeric weights/delays changed but names and shapes are intact.
+    WeightsOnly,
+    /// Structure changed (anything added, removed, renamed, or re-targeted);
+    /// everything must be revalidated.
+    Topology,
+}
+
+/// Validation facts carried across pipeline stages: the resolved name table
+/// and adjacency stay good until a [`Mutation::Topology`], so narrower
+/// mutations revalidate only what they can have broken instead of walking
+/// the whole graph again.
+pub struct ValidationContext {
+    adjacency: std::sync::Arc<AdjacencyIndex>,
+    populations: usize,
+    connections: usize,
+    probes: usize,
+}
+
+impl ValidationContext {
+    /// Fully validate `g` and capture its facts.
+    pub fn full(g: &Graph) -> Result<Self, ValidationError> {
+        g.validate()?;
+        Ok(Self {
+            adjacency: g.adjacency(),
+            populations: g.populations.len(),
+            connections: g.connections.len(),
+            probes: g.probes.len(),
+        })
+    }
+
+    /// Name table and adjacency captured at the last full validation.
+    pub fn adjacency(&self) -> &std::sync::Arc<AdjacencyIndex> {
+        &self.adjacency
+    }
+
+    fn shape_unchanged(&self, g: &Graph) -> bool {
+        self.populations == g.populations.len()
+            && self.connections == g.connections.len()
+            && self.probes == g.probes.len()
+    }
+
+    /// Revalidate only what `mutation` can have invalidated, refreshing the
+    /// carried facts. A declared narrow mutation that nevertheless changed
+    /// the graph's shape falls back to a full pass rather than trusting the
+    /// label.
+    pub fn revalidate(&mut self, g: &Graph, mutation: Mutation) -> Result<(), ValidationError> {
+        if mutation == Mutation::Topology || !self.shape_unchanged(g) {
+            *self = Self::full(g)?;
+            return Ok(());
+        }
+        match mutation {
+            Mutation::AttributesOnly => Ok(()),
+            Mutation::WeightsOnly => check_weights_finite(g),
+            Mutation::Topology => unreachable!("handled above"),
+        }
+    }
+}
+
+/// Bulk finiteness scan over scalar weights/delays and synapse planes: the
+/// weight-only fast path of [`ValidationContext::revalidate`].
+fn check_weights_finite(g: &Graph) -> Result<(), ValidationError> {
+    for c in &g.connections {
+        if !c.weight.is_finite() {
+            return Err(ValidationError(format!("connection {}->{} has non-finite weight", c.pre, c.post)));
+        }
+        if !c.delay_ms.is_finite() || c.delay_ms < 0.0 {
+            return Err(ValidationError(format!(
+                "connection {}->{} has invalid delay_ms {}",
+                c.pre, c.post, c.delay_ms
+            )));
+        }
+        if let Some(m) = &c.synapses {
+            if !m.weights.iter().all(|w| w.is_finite()) {
+                return Err(ValidationError(format!(
+                    "connection {}->{} has non-finite synapse weight",
+                    c.pre, c.post
+                )));
+            }
+        }
+    }
+    Ok(())
+}
+
+/// Flavor of [`Graph::structural_hash`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum StructuralHashKind {
+    /// Population sizes and models plus edge endpoints. Names, weights and
+    /// delays are ignored, so two graphs that differ only in labeling or
+    /// trained parameters collide — which is the point for dedup.
+    Topology,
+    /// [`StructuralHashKind::Topology`] plus the per-edge weight and delay
+    /// planes (bit-exact).
+    TopologyAndWeights,
+}
+
+const FNV_OFFSET: u64 = 0xcbf2_9ce4_8422_2325;
+const FNV_PRIME: u64 = 0x100_0000_01b3;
+
+fn fnv1a(mut h: u64, bytes: &[u8]) -> u64 {
+    for &b in bytes {
+        h ^= b as u64;
+        h = h.wrapping_mul(FNV_PRIME);
+    }
+    h
+}
+
+/// Edge count above which structural hashing folds row chunks in parallel.
+const PARALLEL_HASH_EDGE_THRESHOLD: usize = 1 << 16;
+
+/// Hash a contiguous range of CSR rows. Rows are canonicalized by sorting
+/// each row's entries so declaration order of connections does not leak into
+/// the digest.
+fn hash_rows(g: &Graph, adj: &AdjacencyIndex, rows: std::ops::Range<usize>, kind: StructuralHashKind) -> u64 {
+    let mut h = FNV_OFFSET;
+    let mut entries: Vec<(u32, u64, u64)> = Vec::new();
+    for pre in rows {
+        entries.clear();
+        let cols = adj.out_edges(pre as u32);
+        let conns = adj.out_connections(pre as u32);
+        for (&post, &ci) in cols.iter().zip(conns) {
+            let (w, d) = match kind {
+                StructuralHashKind::Topology => (0, 0),
+                StructuralHashKind::TopologyAndWeights => {
+                    let c = &g.connections[ci as usize];
+                    (c.weight.to_bits() as u64, c.delay_ms.to_bits() as u64)
+                }
+            };
+            entries.push((post, w, d));
+        }
+        entries.sort_unstable();
+        h = fnv1a(h, &(entries.len() as u64).to_le_bytes());
+        for (post, w, d) in &entries {
+            h = fnv1a(h, &post.to_le_bytes());
+            if kind == StructuralHashKind::TopologyAndWeights {
+                h = fnv1a(h, &w.to_le_bytes());
+                h = fnv1a(h, &d.to_le_bytes());
+            }
+        }
+    }
+    h
+}
+
+impl Graph {
+    /// Canonical structural hash: a merkle-style fold over the CSR adjacency
+    /// form, invariant under population renaming and connection declaration
+    /// order. Large edge sets are hashed as parallel row chunks whose digests
+    /// are combined in row order, so the result is independent of thread
+    /// count. Unresolved (dangling) connections are outside the CSR and thus
+    /// outside the hash; validate first if that matters.
+    pub fn structural_hash(&self, kind: StructuralHashKind) -> u64 {
+        let adj = self.adjacency();
+        let n = adj.num_populations();
+
+        // Header: population structure in ID (declaration) order, names excluded.
+        let mut header = FNV_OFFSET;
+        header = fnv1a(header, &(n as u64).to_le_bytes());
+        for p in &self.populations {
+            header = fnv1a(header, &p.size.to_le_bytes());
+            header = fnv1a(header, p.model.as_bytes());
+            header = fnv1a(header, &[0]);
+        }
+
+        let edges: usize = self.connections.len();
+        let digests: Vec<u64> = if edges >= PARALLEL_HASH_EDGE_THRESHOLD && n > 1 {
+            let workers = std::thread::available_parallelism().map(|v| v.get()).unwrap_or(1).min(8).min(n);
+            let chunk = n.div_ceil(workers);
+            std::thread::scope(|s| {
+                let handles: Vec<_> = (0..n)
+                    .step_by(chunk)
+                    .map(|start| {
+                        let end = (start + chunk).min(n);
+                        let adj = &adj;
+                        s.spawn(move || hash_rows(self, adj, start..end, kind))
+                    })
+                    .collect();
+                handles.into_iter().map(|h| h.join().expect("hash worker panicked")).collect()
+            })
+        } else {
+            vec![hash_rows(self, &adj, 0..n, kind)]
+        };
+
+        let mut h = header;
+        for d in digests {
+            h = fnv1a(h, &d.to_le_bytes());
+        }
+        h
+    }
+}
+
+/// Batch dedup over structural hashes: the first graph seen with a given
+/// structure becomes the representative, later ones are reported as
+/// duplicates of it. Compile the representatives, then re-emit per-variant
+/// artifacts by patching weight planes.
+#[derive(Debug)]
+pub struct DedupIndex {
+    kind: StructuralHashKind,
+    reps: std::collections::HashMap<u64, String>,
+    duplicates: usize,
+}
+
+impl DedupIndex {
+    pub fn new(kind: StructuralHashKind) -> Self {
+        Self { kind, reps: std::collections::HashMap::new(), duplicates: 0 }
+    }
+
+    /// Record a graph. Returns `None` when this structure is new (the caller
+    /// should compile it), or the representative's name when it is a
+    /// duplicate.
+    pub fn insert(&mut self, g: &Graph) -> Option<&str> {
+        let h = g.structural_hash(self.kind);
+        match self.reps.entry(h) {
+            std::collections::hash_map::Entry::Occupied(e) => {
+                self.duplicates += 1;
+                Some(e.into_mut().as_str())
+            }
+            std::collections::hash_map::Entry::Vacant(e) => {
+                e.insert(g.name.clone());
+                None
+            }
+        }
+    }
+
+    /// Number of distinct structures seen so far.
+    pub fn unique_count(&self) -> usize {
+        self.reps.len()
+    }
+
+    /// Number of graphs that mapped onto an earlier representative.
+    pub fn duplicate_count(&self) -> usize {
+        self.duplicates
+    }
+}
+
 pub const VERSION: &str = "0.0.1";
 
+/// Sectioned, offset-based binary container for NIR graphs (feature "bin").
+///
+/// Layout: an 8-byte magic + format version, a fixed-size section table of
+/// `(id, offset, len)` entries, then independently encoded sections for
+/// metadata, populations, connections, probes, and attributes. Section
+/// payloads are compact JSON: NIR carries free-form `serde_json::Value`
+/// params that bincode cannot round-trip (`deserialize_any`). A reader
+/// can validate the header and pull one section without touching the rest,
+/// so a pass that only needs connections never pays for a multi-hundred-MB
+/// attribute blob. Reads go through seek + exact-length reads rather than a
+/// memory map: the workspace forbids `unsafe`, and the lazy section decode is
+/// where the cold-start win comes from.
+#[cfg(feature = "bin")]
+pub mod container {
+    use super::*;
+    use std::fs::File;
+    use std::io::{self, Read, Seek, SeekFrom, Write};
+    use std::path::Path;
+
+    const MAGIC: &[u8; 4] = b"NIRC";
+    const FORMAT_VERSION: u32 = 1;
+
+    /// Section identifiers. Stable on disk; append-only.
+    #[derive(Debug, Clone, Copy, PartialEq, Eq)]
+    #[repr(u32)]
+    pub enum SectionId {
+        Meta = 1,
+        Populations = 2,
+        Connections = 3,
+        Probes = 4,
+        Attributes = 5,
+    }
+
+    /// Graph-level metadata that is cheap to decode up front.
+    #[derive(Debug, Clone, Serialize, Deserialize)]
+    pub struct Meta {
+        pub name: String,
+        pub dialect: Option<Dialect>,
+    }
+
+    #[derive(Debug, Clone, Copy)]
+    struct SectionEntry {
+        id: u32,
+        offset: u64,
+        len: u64,
+    }
+
+    fn encode_err(e: serde_json::Error) -> io::Error {
+        io::Error::new(io::ErrorKind::InvalidData, format!("container encode: {e}"))
+    }
+
+    fn decode_err(e: serde_json::Error) -> io::Error {
+        io::Error::new(io::ErrorKind::InvalidData, format!("container decode: {e}"))
+    }
+
+    /// Write `graph` to `path` as a sectioned container.
+    pub fn write(graph: &Graph, path: impl AsRef<Path>) -> io::Result<()> {
+        let meta = Meta { name: graph.name.clone(), dialect: graph.dialect.clone() };
+        let sections: Vec<(SectionId, Vec<u8>)> = vec![
+            (SectionId::Meta, serde_json::to_vec(&meta).map_err(encode_err)?),
+            (SectionId::Populations, serde_json::to_vec(&graph.populations).map_err(encode_err)?),
+            (SectionId::Connections, serde_json::to_vec(&graph.connections).map_err(encode_err)?),
+            (SectionId::Probes, serde_json::to_vec(&graph.probes).map_err(encode_err)?),
+            (SectionId::Attributes, serde_json::to_vec(&graph.attributes).map_err(encode_err)?),
+        ];
+
+        let mut f = File::create(path)?;
+        f.write_all(MAGIC)?;
+        f.write_all(&FORMAT_VERSION.to_le_bytes())?;
+        f.write_all(&(sections.len() as u32).to_le_bytes())?;
+        // Section table: (id u32, offset u64, len u64) per entry.
+        let header_len = 4 + 4 + 4 + sections.len() * 20;
+        let mut offset = header_len as u64;
+        for (id, bytes) in &sections {
+            f.write_all(&(*id as u32).to_le_bytes())?;
+            f.write_all(&offset.to_le_bytes())?;
+            f.write_all(&(bytes.len() as u64).to_le_bytes())?;
+            offset += bytes.len() as u64;
+        }
+        for (_, bytes) in &sections {
+            f.write_all(bytes)?;
+        }
+        f.flush()
+    }
+
+    /// Lazy reader over a sectioned container. `open` only reads the header
+    /// and section table; each accessor decodes its section on first call and
+    /// caches the result for the lifetime of the reader.
+    pub struct Container {
+        file: File,
+        sections: Vec<SectionEntry>,
+        meta: Option<Meta>,
+        populations: Option<Vec<Population>>,
+        connections: Option<Vec<Connection>>,
+        probes: Option<Vec<Probe>>,
+        attributes: Option<IndexMap<String, serde_json::Value>>,
+    }
+
+    impl Container {
+        pub fn open(path: impl AsRef<Path>) -> io::Result<Self> {
+            let mut file = File::open(path)?;
+            let mut magic = [0u8; 4];
+            file.read_exact(&mut magic)?;
+            if &magic != MAGIC {
+                return Err(io::Error::new(io::ErrorKind::InvalidData, "not a NIR container (bad magic)"));
+            }
+            let mut u32buf = [0u8; 4];
+            file.read_exact(&mut u32buf)?;
+            let version = u32::from_le_bytes(u32buf);
+            if version != FORMAT_VERSION {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidData,
+                    format!("unsupported container version {version} (expected {FORMAT_VERSION})"),
+                ));
+            }
+            file.read_exact(&mut u32buf)?;
+            let count = u32::from_le_bytes(u32buf) as usize;
+            let mut sections = Vec::with_capacity(count);
+            let mut u64buf = [0u8; 8];
+            for _ in 0..count {
+                file.read_exact(&mut u32buf)?;
+                let id = u32::from_le_bytes(u32buf);
+                file.read_exact(&mut u64buf)?;
+                let offset = u64::from_le_bytes(u64buf);
+                file.read_exact(&mut u64buf)?;
+                let len = u64::from_le_bytes(u64buf);
+                sections.push(SectionEntry { id, offset, len });
+            }
+            let file_len = file.metadata()?.len();
+            for s in &sections {
+                if s.offset.checked_add(s.len).map(|end| end > file_len).unwrap_or(true) {
+                    return Err(io::Error::new(
+                        io::ErrorKind::InvalidData,
+                        format!("section {} extends past end of file", s.id),
+                    ));
+                }
+            }
+            Ok(Self {
+                file,
+                sections,
+                meta: None,
+                populations: None,
+                connections: None,
+                probes: None,
+                attributes: None,
+            })
+        }
+
+        /// Byte length of a section without decoding it (None if absent).
+        pub fn section_len(&self, id: SectionId) -> Option<u64> {
+            self.sections.iter().find(|s| s.id == id as u32).map(|s| s.len)
+        }
+
+        fn read_section(&mut self, id: SectionId) -> io::Result<Vec<u8>> {
+            let entry = self
+                .sections
+                .iter()
+                .find(|s| s.id == id as u32)
+                .copied()
+                .ok_or_else(|| io::Error::new(io::ErrorKind::NotFound, format!("section {:?} missing", id)))?;
+            self.file.seek(SeekFrom::Start(entry.offset))?;
+            let mut buf = vec![0u8; entry.len as usize];
+            self.file.read_exact(&mut buf)?;
+            Ok(buf)
+        }
+
+        pub fn meta(&mut self) -> io::Result<&Meta> {
+            if self.meta.is_none() {
+                let bytes = self.read_section(SectionId::Meta)?;
+                self.meta = Some(serde_json::from_slice(&bytes).map_err(decode_err)?);
+            }
+            Ok(self.meta.as_ref().expect("meta cached"))
+        }
+
+        pub fn populations(&mut self) -> io::Result<&[Population]> {
+            if self.populations.is_none() {
+                let bytes = self.read_section(SectionId::Populations)?;
+                self.populations = Some(serde_json::from_slice(&bytes).map_err(decode_err)?);
+            }
+            Ok(self.populations.as_deref().expect("populations cached"))
+        }
+
+        pub fn connections(&mut self) -> io::Result<&[Connection]> {
+            if self.connections.is_none() {
+                let bytes = self.read_section(SectionId::Connections)?;
+                self.connections = Some(serde_json::from_slice(&bytes).map_err(decode_err)?);
+            }
+            Ok(self.connections.as_deref().expect("connections cached"))
+        }
+
+        pub fn probes(&mut self) -> io::Result<&[Probe]> {
+            if self.probes.is_none() {
+                let bytes = self.read_section(SectionId::Probes)?;
+                self.probes = Some(serde_json::from_slice(&bytes).map_err(decode_err)?);
+            }
+            Ok(self.probes.as_deref().expect("probes cached"))
+        }
+
+        pub fn attributes(&mut self) -> io::Result<&IndexMap<String, serde_json::Value>> {
+            if self.attributes.is_none() {
+                let bytes = self.read_section(SectionId::Attributes)?;
+                self.attributes = Some(serde_json::from_slice(&bytes).map_err(decode_err)?);
+            }
+            Ok(self.attributes.as_ref().expect("attributes cached"))
+        }
+
+        /// Assemble a full owned [`Graph`] (decodes every section).
+        pub fn read_graph(&mut self) -> io::Result<Graph> {
+            let meta = self.meta()?.clone();
+            let mut g = Graph::new(meta.name);
+            g.dialect = meta.dialect;
+            g.populations = self.populations()?.to_vec();
+            g.connections = self.connections()?.to_vec();
+            g.probes = self.probes()?.to_vec();
+            g.attributes = self.attributes()?.clone();
+            Ok(g)
+        }
+    }
+
+    /// Element-at-a-time sink for importers. Frontends stream populations and
+    /// connections into a sink instead of materializing a whole [`Graph`], so
+    /// import memory is bounded by one record rather than the model.
+    /// [`Graph`] itself implements the trait (in-memory accumulation) and
+    /// [`StreamingWriter`] writes straight into a container file.
+    pub trait GraphSink {
+        fn set_name(&mut self, name: &str);
+        fn set_dialect(&mut self, dialect: Dialect);
+        fn push_population(&mut self, p: Population) -> io::Result<()>;
+        fn push_connection(&mut self, c: Connection) -> io::Result<()>;
+        fn push_probe(&mut self, p: Probe) -> io::Result<()>;
+        fn push_attribute(&mut self, key: String, value: serde_json::Value) -> io::Result<()>;
+    }
+
+    impl GraphSink for Graph {
+        fn set_name(&mut self, name: &str) {
+            self.name = name.to_string();
+        }
+        fn set_dialect(&mut self, dialect: Dialect) {
+            self.dialect = Some(dialect);
+        }
+        fn push_population(&mut self, p: Population) -> io::Result<()> {
+            self.populations.push(p);
+            Ok(())
+        }
+        fn push_connection(&mut self, c: Connection) -> io::Result<()> {
+            self.connections.push(c);
+            Ok(())
+        }
+        fn push_probe(&mut self, p: Probe) -> io::Result<()> {
+            self.probes.push(p);
+            Ok(())
+        }
+        fn push_attribute(&mut self, key: String, value: serde_json::Value) -> io::Result<()> {
+            self.attributes.insert(key, value);
+            Ok(())
+        }
+    }
+
+    /// Streaming container writer: a [`GraphSink`] that encodes each record
+    /// into its section as it arrives, so nothing larger than one record is
+    /// buffered. The fixed five-entry section table is reserved up front and
+    /// patched with final offsets on [`StreamingWriter::finish`]; the meta
+    /// section is written last so the name can still change mid-stream.
+    /// Sections must be fed in container order (populations, then
+    /// connections, then probes, then attributes) — a push for an earlier
+    /// section after a later one has started is an error.
+    pub struct StreamingWriter {
+        out: io::BufWriter<File>,
+        pos: u64,
+        meta: Meta,
+        entries: Vec<SectionEntry>,
+        open: Option<SectionEntry>,
+    }
+
+    impl StreamingWriter {
+        const TABLE_OFFSET: u64 = 4 + 4 + 4;
+        const SECTION_COUNT: usize = 5;
+
+        pub fn create(path: impl AsRef<Path>, name: impl Into<String>) -> io::Result<Self> {
+            let mut out = io::BufWriter::new(File::create(path)?);
+            out.write_all(MAGIC)?;
+            out.write_all(&FORMAT_VERSION.to_le_bytes())?;
+            out.write_all(&(Self::SECTION_COUNT as u32).to_le_bytes())?;
+            // Placeholder table, patched in finish().
+            out.write_all(&[0u8; Self::SECTION_COUNT * 20])?;
+            Ok(Self {
+                out,
+                pos: Self::TABLE_OFFSET + (Self::SECTION_COUNT * 20) as u64,
+                meta: Meta { name: name.into(), dialect: None },
+                entries: Vec::with_capacity(Self::SECTION_COUNT),
+                open: None,
+            })
+        }
+
+        fn write(&mut self, bytes: &[u8]) -> io::Result<()> {
+            self.out.write_all(bytes)?;
+            self.pos += bytes.len() as u64;
+            Ok(())
+        }
+
+        fn close_open(&mut self) -> io::Result<()> {
+            if let Some(mut entry) = self.open.take() {
+                let terminator: &[u8] = if entry.id == SectionId::Attributes as u32 { b"}" } else { b"]" };
+                self.write(terminator)?;
+                entry.len = self.pos - entry.offset;
+                self.entries.push(entry);
+            }
+            Ok(())
+        }
+
+        /// Route a record into `id`'s section, opening it (and closing the
+        /// previous one) on first use.
+        fn push_into(&mut self, id: SectionId, item: &[u8]) -> io::Result<()> {
+            match &self.open {
+                Some(entry) if entry.id == id as u32 => {
+                    self.write(b",")?;
+                }
+                _ => {
+                    let past = self.open.as_ref().map(|e| e.id).or_else(|| self.entries.iter().map(|e| e.id).max());
+                    if past.map(|p| p >= id as u32).unwrap_or(false) {
+                        return Err(io::Error::new(
+                            io::ErrorKind::InvalidInput,
+                            format!("section {:?} pushed after a later section started", id),
+                        ));
+                    }
+                    self.close_open()?;
+                    self.open = Some(SectionEntry { id: id as u32, offset: self.pos, len: 0 });
+                    let opener: &[u8] = if id == SectionId::Attributes { b"{" } else { b"[" };
+                    self.write(opener)?;
+                }
+            }
+            self.write(item)
+        }
+
+        /// Close any open section, write empty payloads for sections that
+        /// never received a record plus the meta section, and patch the table.
+        pub fn finish(mut self) -> io::Result<()> {
+            self.close_open()?;
+            for id in [SectionId::Populations, SectionId::Connections, SectionId::Probes, SectionId::Attributes] {
+                if self.entries.iter().any(|e| e.id == id as u32) {
+                    continue;
+                }
+                let offset = self.pos;
+                let body: &[u8] = if id == SectionId::Attributes { b"{}" } else { b"[]" };
+                self.write(body)?;
+                self.entries.push(SectionEntry { id: id as u32, offset, len: self.pos - offset });
+            }
+            let meta_bytes = serde_json::to_vec(&self.meta).map_err(encode_err)?;
+            let offset = self.pos;
+            self.write(&meta_bytes)?;
+            self.entries.push(SectionEntry { id: SectionId::Meta as u32, offset, len: meta_bytes.len() as u64 });
+
+            self.out.flush()?;
+            let mut f = self.out.into_inner().map_err(|e| io::Error::other(e.to_string()))?;
+            f.seek(SeekFrom::Start(Self::TABLE_OFFSET))?;
+            self.entries.sort_by_key(|e| e.id);
+            for e in &self.entries {
+                f.write_all(&e.id.to_le_bytes())?;
+                f.write_all(&e.offset.to_le_bytes())?;
+                f.write_all(&e.len.to_le_bytes())?;
+            }
+            f.flush()
+        }
+    }
+
+    impl GraphSink for StreamingWriter {
+        fn set_name(&mut self, name: &str) {
+            self.meta.name = name.to_string();
+        }
+        fn set_dialect(&mut self, dialect: Dialect) {
+            self.meta.dialect = Some(dialect);
+        }
+        fn push_population(&mut self, p: Population) -> io::Result<()> {
+            let bytes = serde_json::to_vec(&p).map_err(encode_err)?;
+            self.push_into(SectionId::Populations, &bytes)
+        }
+        fn push_connection(&mut self, c: Connection) -> io::Result<()> {
+            let bytes = serde_json::to_vec(&c).map_err(encode_err)?;
+            self.push_into(SectionId::Connections, &bytes)
+        }
+        fn push_probe(&mut self, p: Probe) -> io::Result<()> {
+            let bytes = serde_json::to_vec(&p).map_err(encode_err)?;
+            self.push_into(SectionId::Probes, &bytes)
+        }
+        fn push_attribute(&mut self, key: String, value: serde_json::Value) -> io::Result<()> {
+            let mut bytes = serde_json::to_vec(&key).map_err(encode_err)?;
+            bytes.push(b':');
+            bytes.extend(serde_json::to_vec(&value).map_err(encode_err)?);
+            self.push_into(SectionId::Attributes, &bytes)
+        }
+    }
+}
+
 /// Pre-built NIR graph generators for tests and examples.
 pub mod fixtures {
     use super::*;
@@ -180,6 +1108,7 @@ pub mod fixtures {
 
     /// Construct a simple feed-forward chain of populations.
     /// - layer_sizes: sizes of successive layers (len >= 1). layer[0] is "source".
+    ///
     /// Population ids: p0, p1, ..., p{n-1}
     /// Connections: p{i} -> p{i+1} with weight=0.5, delay_ms=1.0
     pub fn chain(layer_sizes: &[u32]) -> Graph {
@@ -206,6 +1135,7 @@ pub mod fixtures {
                 weight: 0.5,
                 delay_ms: 1.0,
                 plasticity: None,
+                synapses: None,
             });
         }
         g.ensure_version_tag();
@@ -237,6 +1167,7 @@ pub mod fixtures {
                 weight,
                 delay_ms,
                 plasticity: None,
+                synapses: None,
             });
         }
         g.ensure_version_tag();
@@ -263,12 +1194,174 @@ pub mod fixtures {
                 weight,
                 delay_ms,
                 plasticity: None,
+                synapses: None,
             });
         }
         g.ensure_version_tag();
         g
     }
 }
+
+/// Parametric synthetic graph generation for load tests and benchmarks.
+///
+/// Unlike [`fixtures`], which builds a handful of fixed shapes, this module
+/// scales to production-like topologies (millions of synapses): population
+/// counts, sizes, out-degree distribution, and connection thinning are all
+/// configurable, generation is deterministic for a seed, and all vectors are
+/// reserved up front so construction never reallocates mid-build.
+pub mod generate {
+    use super::{Connection, Graph, Population};
+    use serde_json::json;
+
+    /// Out-degree distribution over populations.
+    #[derive(Debug, Clone)]
+    pub enum DegreeDistribution {
+        /// Every population sends exactly `out_degree` connections.
+        Uniform { out_degree: u32 },
+        /// Discrete Pareto out-degrees: `d = clamp(floor(u^(-1/(exponent-1))), 1, max_degree)`.
+        /// Exponents around 2..3 give the heavy-tailed fan-outs we see in
+        /// cortical-style models.
+        PowerLaw { exponent: f64, max_degree: u32 },
+    }
+
+    #[derive(Debug, Clone)]
+    pub struct GeneratorConfig {
+        pub populations: u32,
+        pub population_size: u32,
+        pub degree: DegreeDistribution,
+        /// Per-edge keep probability in (0, 1]; thins sampled degrees.
+        pub connection_probability: f64,
+        pub weight: f32,
+        pub delay_ms: f32,
+        pub seed: u64,
+    }
+
+    impl Default for GeneratorConfig {
+        fn default() -> Self {
+            Self {
+                populations: 1024,
+                population_size: 64,
+                degree: DegreeDistribution::Uniform { out_degree: 8 },
+                connection_probability: 1.0,
+                weight: 0.5,
+                delay_ms: 1.0,
+                seed: 0x5EED,
+            }
+        }
+    }
+
+    /// Minimal deterministic xorshift64 generator; good enough for topology
+    /// sampling and free of external dependencies.
+    #[derive(Debug, Clone)]
+    pub struct Rng(u64);
+
+    impl Rng {
+        pub fn new(seed: u64) -> Self {
+            Self(seed | 1)
+        }
+        pub fn next_u64(&mut self) -> u64 {
+            let mut x = self.0;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            self.0 = x;
+            x
+        }
+        /// Uniform in [0, 1).
+        pub fn next_f64(&mut self) -> f64 {
+            (self.next_u64() >> 11) as f64 / (1u64 << 53) as f64
+        }
+    }
+
+    fn sample_degree(cfg: &GeneratorConfig, rng: &mut Rng) -> u32 {
+        match cfg.degree {
+            DegreeDistribution::Uniform { out_degree } => out_degree,
+            DegreeDistribution::PowerLaw { exponent, max_degree } => {
+                let u = (1.0 - rng.next_f64()).max(f64::EPSILON);
+                let d = u.powf(-1.0 / (exponent - 1.0)).floor();
+                (d as u32).clamp(1, max_degree.max(1))
+            }
+        }
+    }
+
+    /// Expected connection count for a config; used to pre-reserve capacity
+    /// and useful for sizing load tests before building anything.
+    pub fn expected_connections(cfg: &GeneratorConfig) -> usize {
+        let mean_degree = match cfg.degree {
+            DegreeDistribution::Uniform { out_degree } => out_degree as f64,
+            // Pareto mean (exponent > 2), pessimistically capped.
+            DegreeDistribution::PowerLaw { exponent, max_degree } => {
+                if exponent > 2.0 {
+                    ((exponent - 1.0) / (exponent - 2.0)).min(max_degree as f64)
+                } else {
+                    max_degree as f64
+                }
+            }
+        };
+        (cfg.populations as f64 * mean_degree * cfg.connection_probability).ceil() as usize
+    }
+
+    /// Build a graph from the config. Deterministic for a given config and
+    /// seed; all vectors are reserved before the fill loops.
+    pub fn build(cfg: &GeneratorConfig) -> Graph {
+        assert!(cfg.populations >= 2, "generator requires at least 2 populations");
+        assert!(
+            cfg.connection_probability > 0.0 && cfg.connection_probability <= 1.0,
+            "connection_probability must be in (0, 1]"
+        );
+        let n = cfg.populations as usize;
+        let mut rng = Rng::new(cfg.seed);
+
+        let names: Vec<String> = (0..n).map(|i| format!("p{}", i)).collect();
+        let mut g = Graph::new(format!("generated_{}", n));
+        g.populations.reserve_exact(n);
+        for name in &names {
+            g.populations.push(Population {
+                name: name.clone(),
+                size: cfg.population_size,
+                model: "lif".into(),
+                params: json!({"tau_m": 0.02, "v_th": 1.0}),
+            });
+        }
+
+        g.connections.reserve(expected_connections(cfg));
+        for pre in 0..n {
+            let degree = sample_degree(cfg, &mut rng);
+            for _ in 0..degree {
+                if cfg.connection_probability < 1.0 && rng.next_f64() >= cfg.connection_probability
+                {
+                    continue;
+                }
+                let mut post = (rng.next_u64() % n as u64) as usize;
+                if post == pre {
+                    post = (post + 1) % n;
+                }
+                g.connections.push(Connection {
+                    pre: names[pre].clone(),
+                    post: names[post].clone(),
+                    weight: cfg.weight,
+                    delay_ms: cfg.delay_ms,
+                    plasticity: None,
+                    synapses: None,
+                });
+            }
+        }
+        g.ensure_version_tag();
+        g
+    }
+
+    /// Build and write straight into the sectioned binary container without
+    /// keeping a serialized text form around; the graph itself still
+    /// materializes in memory since the container stores whole sections.
+    #[cfg(feature = "bin")]
+    pub fn build_to_container<P: AsRef<std::path::Path>>(
+        cfg: &GeneratorConfig,
+        path: P,
+    ) -> std::io::Result<()> {
+        build(cfg).write_container(path)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -302,6 +1395,7 @@ mod tests {
             weight: 0.5,
             delay_ms: 1.0,
             plasticity: None,
+                synapses: None,
         });
         let s = g.to_yaml_string().unwrap();
         let g2 = Graph::from_yaml_str(&s).unwrap();
@@ -330,6 +1424,7 @@ mod tests {
             weight: 0.1,
             delay_ms: 0.0,
             plasticity: None,
+                synapses: None,
         });
         g.validate().unwrap();
     }
@@ -349,7 +1444,219 @@ mod tests {
             weight: 1.0,
             delay_ms: 0.0,
             plasticity: None,
+                synapses: None,
+        });
+        assert!(g.validate().is_err());
+    }
+
+    #[test]
+    fn structural_hash_ignores_names_and_declaration_order() {
+        let mk = |names: [&str; 2], reversed: bool, w: f32| {
+            let mut g = Graph::new("variant");
+            for n in names {
+                g.populations.push(Population {
+                    name: n.into(),
+                    size: 4,
+                    model: "LIF".into(),
+                    params: serde_json::json!({}),
+                });
+            }
+            let mut conns = vec![
+                (names[0], names[1], w),
+                (names[0], names[0], 0.25),
+            ];
+            if reversed {
+                conns.reverse();
+            }
+            for (pre, post, weight) in conns {
+                g.connections.push(Connection {
+                    pre: pre.into(),
+                    post: post.into(),
+                    weight,
+                    delay_ms: 1.0,
+                    plasticity: None,
+                    synapses: None,
+                });
+            }
+            g
+        };
+        let a = mk(["x", "y"], false, 0.5);
+        let b = mk(["p", "q"], true, 0.5);
+        let c = mk(["x", "y"], false, 0.75);
+        for kind in [StructuralHashKind::Topology, StructuralHashKind::TopologyAndWeights] {
+            assert_eq!(a.structural_hash(kind), b.structural_hash(kind), "{kind:?} must ignore labels and order");
+        }
+        assert_eq!(a.structural_hash(StructuralHashKind::Topology), c.structural_hash(StructuralHashKind::Topology));
+        assert_ne!(
+            a.structural_hash(StructuralHashKind::TopologyAndWeights),
+            c.structural_hash(StructuralHashKind::TopologyAndWeights),
+            "weight plane must show up in the weights flavor"
+        );
+    }
+
+    #[test]
+    fn dedup_index_and_parallel_hash_chunks() {
+        // Enough duplicate edges to cross the parallel threshold; the chunked
+        // fold must agree with itself across graphs that only differ in names.
+        let edges = super::PARALLEL_HASH_EDGE_THRESHOLD + 321;
+        let mk = |a: &str, b: &str| {
+            let mut g = Graph::new(a);
+            for (n, sz) in [(a, 8u32), (b, 8u32)] {
+                g.populations.push(Population {
+                    name: n.into(),
+                    size: sz,
+                    model: "LIF".into(),
+                    params: serde_json::json!({}),
+                });
+            }
+            for i in 0..edges {
+                g.connections.push(Connection {
+                    pre: a.into(),
+                    post: b.into(),
+                    weight: (i % 7) as f32 * 0.1,
+                    delay_ms: 0.0,
+                    plasticity: None,
+                    synapses: None,
+                });
+            }
+            g
+        };
+        let g1 = mk("left", "right");
+        let g2 = mk("gauche", "droite");
+        let mut small = fixtures::chain(&[8, 8]);
+        small.name = "small".into();
+
+        let mut idx = DedupIndex::new(StructuralHashKind::TopologyAndWeights);
+        assert_eq!(idx.insert(&g1), None);
+        assert_eq!(idx.insert(&g2), Some("left"));
+        assert_eq!(idx.insert(&small), None);
+        assert_eq!(idx.unique_count(), 2);
+        assert_eq!(idx.duplicate_count(), 1);
+    }
+
+    #[test]
+    fn pass_meta_is_in_memory_only_and_survives_clone() {
+        let mut g = fixtures::chain(&[2, 3]);
+        g.meta.partition = Some(PartitionAssignment {
+            parts: 2,
+            assignment: vec![("p0".into(), 0), ("p1".into(), 1)],
+        });
+        g.meta.rv_vectorize = Some(RvVectorize { enabled: true, vlen_bytes: 64 });
+
+        // Clones carry the typed table; the serialized form does not, so a
+        // disk round-trip comes back with an empty table (consumers fall back
+        // to the JSON attributes).
+        assert_eq!(g.clone().meta, g.meta);
+        let json = g.to_json_string().unwrap();
+        assert!(!json.contains("rv_vectorize"));
+        let back = Graph::from_json_str(&json).unwrap();
+        assert_eq!(back.meta, PassMeta::default());
+    }
+
+    #[test]
+    fn validation_context_revalidates_only_dirty_region() {
+        let mut g = fixtures::chain(&[2, 3]);
+        let mut ctx = ValidationContext::full(&g).expect("initial full validation");
+        assert_eq!(ctx.adjacency().num_populations(), 2);
+
+        // Weight-only mutation: the fast path catches a NaN without a
+        // full revalidation.
+        g.connections[0].weight = f32::NAN;
+        assert!(ctx.revalidate(&g, Mutation::WeightsOnly).is_err());
+        g.connections[0].weight = 0.25;
+        ctx.revalidate(&g, Mutation::WeightsOnly).expect("finite weights pass");
+
+        // Attribute-only mutations have nothing to recheck.
+        g.attributes.insert("note".into(), serde_json::json!("x"));
+        ctx.revalidate(&g, Mutation::AttributesOnly).expect("attrs ok");
+
+        // A shape change under a narrow label falls back to a full pass,
+        // which catches the dangling probe target.
+        g.probes.push(Probe { target: "missing".into(), kind: "spikes".into() });
+        assert!(ctx.revalidate(&g, Mutation::AttributesOnly).is_err());
+        g.probes.pop();
+        ctx.revalidate(&g, Mutation::Topology).expect("full revalidation refreshes facts");
+    }
+
+    #[test]
+    fn adjacency_index_csr_and_degrees() {
+        let g = fixtures::star(32, 8, 3, 0.5, 1.0);
+        let adj = g.adjacency();
+        assert_eq!(adj.num_populations(), 4);
+        let center = adj.id_of("center").unwrap();
+        assert_eq!(adj.out_degree(center), 3);
+        assert_eq!(adj.in_degree(center), 0);
+        let s1 = adj.id_of("s1").unwrap();
+        assert_eq!(adj.in_degree(s1), 1);
+        assert!(adj.out_edges(center).contains(&s1));
+        // Edge slots map back to connection indices in declaration order.
+        let conns = adj.out_connections(center);
+        assert_eq!(conns, &[0, 1, 2]);
+        assert_eq!(adj.name_of(s1), "s1");
+        // Cached: a second call returns the same index.
+        assert!(std::sync::Arc::ptr_eq(&adj, &g.adjacency()));
+        // Clones start with a fresh cache.
+        let g2 = g.clone();
+        assert!(!std::sync::Arc::ptr_eq(&adj, &g2.adjacency()));
+    }
+
+    #[test]
+    fn adjacency_index_records_unresolved_edges() {
+        let mut g = Graph::new("bad");
+        g.populations.push(Population {
+            name: "a".into(),
+            size: 1,
+            model: "LIF".into(),
+            params: serde_json::json!({}),
+        });
+        g.connections.push(Connection {
+            pre: "a".into(),
+            post: "ghost".into(),
+            weight: 1.0,
+            delay_ms: 0.0,
+            plasticity: None,
+                synapses: None,
         });
+        let adj = g.adjacency();
+        assert_eq!(adj.unresolved_connections(), &[0]);
+        assert!(g.validate().is_err());
+    }
+
+    #[test]
+    fn synapse_matrix_dims_validated() {
+        let mut g = Graph::new("syn");
+        g.populations.push(Population {
+            name: "a".into(),
+            size: 2,
+            model: "LIF".into(),
+            params: serde_json::json!({}),
+        });
+        g.populations.push(Population {
+            name: "b".into(),
+            size: 2,
+            model: "LIF".into(),
+            params: serde_json::json!({}),
+        });
+        g.connections.push(Connection {
+            pre: "a".into(),
+            post: "b".into(),
+            weight: 0.5,
+            delay_ms: 0.0,
+            plasticity: None,
+            synapses: Some(SynapseMatrix {
+                row_ptr: vec![0, 1, 3],
+                col_idx: vec![0, 1, 0],
+                weights: vec![0.1, 0.2, 0.3],
+            }),
+        });
+        g.validate().unwrap();
+        // Column index out of range for post population
+        g.connections[0].synapses.as_mut().unwrap().col_idx[1] = 9;
+        assert!(g.validate().is_err());
+        // Row pointer count must be pre_size + 1
+        let m = g.connections[0].synapses.as_mut().unwrap();
+        m.col_idx[1] = 1;
+        m.row_ptr = vec![0, 3];
         assert!(g.validate().is_err());
     }
 
@@ -369,4 +1676,125 @@ mod tests {
         let g2 = Graph::from_bytes(&bytes).unwrap();
         assert_eq!(g2.name, "bin");
     }
+
+    #[cfg(feature = "bin")]
+    #[test]
+    fn container_roundtrip_and_lazy_sections() {
+        let g = fixtures::chain(&[4, 8, 2]);
+        let dir = std::env::temp_dir().join("nc_nir_container_test");
+        std::fs::create_dir_all(&dir).unwrap();
+        let path = dir.join("chain.nirc");
+        g.write_container(&path).unwrap();
+
+        let mut c = Graph::open_container(&path).unwrap();
+        // Header-only open: section lengths are known without decoding.
+        assert!(c.section_len(container::SectionId::Connections).unwrap() > 0);
+        // Pull one section lazily.
+        assert_eq!(c.connections().unwrap().len(), 2);
+        assert_eq!(c.meta().unwrap().name, "chain");
+        // Full assembly matches the source graph.
+        let g2 = c.read_graph().unwrap();
+        assert_eq!(g2.populations.len(), 3);
+        assert_eq!(g2.connections.len(), 2);
+        assert_eq!(
+            g2.attributes.get("nir_version").and_then(|v| v.as_str()),
+            Some(VERSION)
+        );
+    }
+
+    #[cfg(feature = "bin")]
+    #[test]
+    fn streaming_writer_matches_whole_graph_write() {
+        use container::GraphSink;
+        let dir = std::env::temp_dir().join("nc_nir_container_test");
+        std::fs::create_dir_all(&dir).unwrap();
+        let path = dir.join("streamed.nirc");
+
+        let src = fixtures::chain(&[4, 8, 2]);
+        let mut w = container::StreamingWriter::create(&path, "ignored").unwrap();
+        w.set_name(&src.name);
+        for p in &src.populations {
+            w.push_population(p.clone()).unwrap();
+        }
+        for c in &src.connections {
+            w.push_connection(c.clone()).unwrap();
+        }
+        for (k, v) in &src.attributes {
+            w.push_attribute(k.clone(), v.clone()).unwrap();
+        }
+        w.finish().unwrap();
+
+        let g = Graph::open_container(&path).unwrap().read_graph().unwrap();
+        assert_eq!(g.to_json_string().unwrap(), src.to_json_string().unwrap());
+
+        // Sections cannot be revisited once a later one has started.
+        let mut w = container::StreamingWriter::create(dir.join("bad.nirc"), "g").unwrap();
+        w.push_connection(src.connections[0].clone()).unwrap();
+        assert!(w.push_population(src.populations[0].clone()).is_err());
+
+        // A finish with no records still yields a well-formed empty container.
+        let empty = dir.join("empty.nirc");
+        container::StreamingWriter::create(&empty, "hollow").unwrap().finish().unwrap();
+        let g = Graph::open_container(&empty).unwrap().read_graph().unwrap();
+        assert_eq!(g.name, "hollow");
+        assert!(g.populations.is_empty() && g.connections.is_empty());
+    }
+
+    #[cfg(feature = "bin")]
+    #[test]
+    fn container_rejects_bad_magic() {
+        let dir = std::env::temp_dir().join("nc_nir_container_test");
+        std::fs::create_dir_all(&dir).unwrap();
+        let path = dir.join("bogus.nirc");
+        std::fs::write(&path, b"not a container at all").unwrap();
+        assert!(Graph::open_container(&path).is_err());
+    }
+
+    #[test]
+    fn generate_uniform_is_deterministic_and_valid() {
+        let cfg = generate::GeneratorConfig {
+            populations: 64,
+            degree: generate::DegreeDistribution::Uniform { out_degree: 4 },
+            ..Default::default()
+        };
+        let g1 = generate::build(&cfg);
+        let g2 = generate::build(&cfg);
+        assert_eq!(g1.to_json_string().unwrap(), g2.to_json_string().unwrap());
+        assert_eq!(g1.populations.len(), 64);
+        assert_eq!(g1.connections.len(), 64 * 4);
+        g1.validate().expect("generated graph validates");
+    }
+
+    #[test]
+    fn generate_power_law_degrees_within_bounds() {
+        let cfg = generate::GeneratorConfig {
+            populations: 256,
+            degree: generate::DegreeDistribution::PowerLaw { exponent: 2.5, max_degree: 32 },
+            seed: 99,
+            ..Default::default()
+        };
+        let g = generate::build(&cfg);
+        let adj = g.adjacency();
+        let mut max_seen = 0usize;
+        for pre in 0..adj.num_populations() {
+            max_seen = max_seen.max(adj.out_degree(pre as u32) as usize);
+        }
+        assert!(max_seen <= 32, "out-degree {} exceeds max_degree", max_seen);
+        assert!(g.connections.len() >= 256, "every population sends at least one edge");
+        g.validate().expect("generated graph validates");
+    }
+
+    #[test]
+    fn generate_connection_probability_thins_edges() {
+        let dense = generate::GeneratorConfig {
+            populations: 128,
+            degree: generate::DegreeDistribution::Uniform { out_degree: 8 },
+            ..Default::default()
+        };
+        let sparse =
+            generate::GeneratorConfig { connection_probability: 0.25, ..dense.clone() };
+        let e_dense = generate::build(&dense).connections.len();
+        let e_sparse = generate::build(&sparse).connections.len();
+        assert!(e_sparse < e_dense / 2, "thinning kept {} of {} edges", e_sparse, e_dense);
+    }
 }
@@ -34,9 +34,26 @@ fn bench_partition_star(c: &mut Criterion) {
     });
 }
 
+fn bench_partition_scaled(c: &mut Criterion) {
+    let targets = ["riscv64gcv_linux"];
+    let mut group = c.benchmark_group("partition/chain_scaled");
+    group.sample_size(10);
+    for &pops in &[1_000usize, 10_000, 100_000] {
+        let sizes = vec![32u32; pops];
+        let g = nir::fixtures::chain(&sizes);
+        group.bench_function(criterion::BenchmarkId::from_parameter(pops), |b| {
+            b.iter(|| {
+                let plan = partition(black_box(&g), black_box(&targets)).expect("partition ok");
+                black_box(plan);
+            })
+        });
+    }
+    group.finish();
+}
+
 criterion_group!(
     name = partition_benches;
     config = Criterion::default();
-    targets = bench_partition_small, bench_partition_medium, bench_partition_star
+    targets = bench_partition_small, bench_partition_medium, bench_partition_star, bench_partition_scaled
 );
 criterion_main!(partition_benches);
\ No newline at end of file
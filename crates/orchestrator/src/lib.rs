@@ -1,6 +1,10 @@
 use anyhow::Result;
 pub use nc_nir as nir;
 pub mod metrics;
+#[cfg(feature = "orchestrator_partition")]
+pub mod partition;
+#[cfg(feature = "orchestrator_partition")]
+pub use partition::MultilevelBuilder;
 use serde::{Serialize, Deserialize};
 #[cfg(feature = "telemetry")]
 use std::collections::BTreeMap;
@@ -10,6 +14,10 @@ use nc_telemetry as telemetry;
 #[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct PartitionPlan {
     pub parts: usize,
+    /// Population name -> part index; empty when the builder only sized the
+    /// plan without placing populations.
+    #[serde(default, skip_serializing_if = "Vec::is_empty")]
+    pub assignment: Vec<(String, usize)>,
 }
 
 pub fn partition(_g: &nir::Graph, _targets: &[&str]) -> Result<PartitionPlan> {
@@ -31,14 +39,14 @@ pub fn partition(_g: &nir::Graph, _targets: &[&str]) -> Result<PartitionPlan> {
     // Compute plan using feature-gated builder when available; otherwise use minimal deterministic fallback.
     #[cfg(feature = "orchestrator_partition")]
     let plan = {
-        let mut builder = GreedyRefineBuilder::new(0xDEAD_BEEFu64);
+        let mut builder = MultilevelBuilder::new(0xDEAD_BEEFu64);
         builder.plan(_g, _targets)
     };
     #[cfg(not(feature = "orchestrator_partition"))]
     let plan = {
         let n = _g.populations.len();
         let parts = if n == 0 { 1 } else { std::cmp::min(n, 4) };
-        PartitionPlan { parts }
+        PartitionPlan { parts, assignment: Vec::new() }
     };
 
     #[cfg(feature = "telemetry")]
@@ -73,8 +81,10 @@ impl GreedyRefineBuilder {
 #[cfg(feature = "orchestrator_partition")]
 impl PartitionBuilder for GreedyRefineBuilder {
     fn plan(&mut self, g: &nir::Graph, targets: &[&str]) -> PartitionPlan {
-        // Deterministic greedy + refinement seed mix using graph metrics and targets.
-        let m = crate::metrics::compute_metrics(g);
+        // Deterministic greedy + refinement seed mix using graph metrics and
+        // targets. Memoized: repeated planning attempts against an unchanged
+        // graph reuse the structural metrics.
+        let m = crate::metrics::metrics_for(g);
 
         // Mix seed with structural metrics and target strings for stability.
         let mut mix: u64 = self.seed
@@ -92,7 +102,7 @@ impl PartitionBuilder for GreedyRefineBuilder {
 
         let n = g.populations.len();
         // Bound the number of parts to [1, min(n, 4)] to keep partitions coarse initially.
-        let upper = std::cmp::min(std::cmp::max(n, 1), 4) as u64;
+        let upper = n.clamp(1, 4) as u64;
         let mut parts = 1 + (mix % upper) as usize;
 
         // Clamp to valid range with respect to node count.
@@ -101,7 +111,7 @@ impl PartitionBuilder for GreedyRefineBuilder {
             parts = max_allowed;
         }
 
-        PartitionPlan { parts }
+        PartitionPlan { parts, assignment: Vec::new() }
     }
 }
 
@@ -136,7 +146,7 @@ mod tests {
         let s = std::fs::read_to_string(&p).expect("read fixture chain_small");
         let g = nir::Graph::from_json_str(&s).expect("parse NIR from json");
         let plan = partition(&g, &["riscv64gcv_linux"]).expect("partition ok");
-        let upper = std::cmp::min(std::cmp::max(g.populations.len(), 1), 4);
+        let upper = g.populations.len().clamp(1, 4);
         assert!(plan.parts >= 1 && plan.parts <= upper);
     }
 
@@ -159,13 +169,13 @@ mod tests {
         // Empty graph -> exactly 1 part
         let g0 = nir::Graph::new("empty");
         let p0 = b.plan(&g0, &["riscv64gcv_linux"]);
-        assert!(p0.parts >= 1 && p0.parts <= 1);
+        assert_eq!(p0.parts, 1);
 
         // Non-empty graph -> parts in [1, min(n, 4)]
         let g = nir::fixtures::star(32, 8, 5, 0.5, 1.0);
         let p = b.plan(&g, &["riscv64gcv_linux"]);
         let n = g.populations.len();
-        let upper = std::cmp::min(std::cmp::max(n, 1), 4);
+        let upper = n.clamp(1, 4);
         assert!(p.parts >= 1 && p.parts <= upper);
     }
 
@@ -177,7 +187,7 @@ mod tests {
         let p1 = b.plan(&g, &[]);
         let p2 = b.plan(&g, &[]);
         assert_eq!(p1.parts, p2.parts);
-        let upper = std::cmp::min(std::cmp::max(g.populations.len(), 1), 4);
+        let upper = g.populations.len().clamp(1, 4);
         assert!(p1.parts >= 1 && p1.parts <= upper);
     }
 
@@ -219,7 +229,7 @@ mod tests {
                 let p1 = b.plan(&g, &t);
                 let p2 = b.plan(&g, &t);
                 prop_assert_eq!(p1.parts, p2.parts);
-                let upper = std::cmp::min(std::cmp::max(g.populations.len(), 1), 4);
+                let upper = g.populations.len().clamp(1, 4);
                 prop_assert!(p1.parts >= 1 && p1.parts <= upper);
             }
         }
@@ -3,6 +3,7 @@
 
 use crate::nir;
 use std::collections::HashMap;
+use std::sync::{Arc, Mutex, OnceLock, Weak};
 
 /// Structural metrics over a NIR graph (population-level).
 #[derive(Debug, Clone, PartialEq)]
@@ -21,6 +22,10 @@ pub struct GraphMetrics {
     pub max_fanout: usize,
 }
 
+/// Below this edge count the serial path wins; thread setup does not
+/// amortize over small graphs.
+const PARALLEL_EDGE_THRESHOLD: usize = 1 << 16;
+
 /// Compute structural metrics from a NIR graph.
 ///
 /// Semantics:
@@ -31,40 +36,63 @@ pub fn compute_metrics(g: &nir::Graph) -> GraphMetrics {
     let node_count = g.populations.len();
     let edge_count = g.connections.len();
 
-    // Initialize maps with all population names to ensure zeros are counted.
-    let mut fan_in: HashMap<&str, usize> = HashMap::with_capacity(node_count);
-    let mut fan_out: HashMap<&str, usize> = HashMap::with_capacity(node_count);
-    for p in &g.populations {
-        fan_in.insert(p.name.as_str(), 0);
-        fan_out.insert(p.name.as_str(), 0);
+    // One id table instead of two name-keyed count maps; degree counting
+    // then indexes dense arrays, which is also what lets chunks merge.
+    let mut ids: HashMap<&str, u32> = HashMap::with_capacity(node_count);
+    for (i, p) in g.populations.iter().enumerate() {
+        ids.insert(p.name.as_str(), i as u32);
     }
 
-    for c in &g.connections {
-        if let Some(x) = fan_out.get_mut(c.pre.as_str()) {
-            *x += 1;
-        }
-        if let Some(x) = fan_in.get_mut(c.post.as_str()) {
-            *x += 1;
+    let count_chunk = |conns: &[nir::Connection]| -> (Vec<u32>, Vec<u32>) {
+        let mut fan_in = vec![0u32; node_count];
+        let mut fan_out = vec![0u32; node_count];
+        for c in conns {
+            if let Some(&pre) = ids.get(c.pre.as_str()) {
+                fan_out[pre as usize] += 1;
+            }
+            if let Some(&post) = ids.get(c.post.as_str()) {
+                fan_in[post as usize] += 1;
+            }
         }
-    }
+        (fan_in, fan_out)
+    };
 
-    let mut sum_in: usize = 0;
-    let mut sum_out: usize = 0;
-    let mut max_in: usize = 0;
-    let mut max_out: usize = 0;
-
-    for p in &g.populations {
-        let fi = *fan_in.get(p.name.as_str()).unwrap_or(&0);
-        let fo = *fan_out.get(p.name.as_str()).unwrap_or(&0);
-        sum_in += fi;
-        sum_out += fo;
-        if fi > max_in {
-            max_in = fi;
-        }
-        if fo > max_out {
-            max_out = fo;
+    let threads = if edge_count >= PARALLEL_EDGE_THRESHOLD {
+        std::thread::available_parallelism().map(|n| n.get()).unwrap_or(1).min(8)
+    } else {
+        1
+    };
+
+    let (fan_in, fan_out) = if threads <= 1 {
+        count_chunk(&g.connections)
+    } else {
+        // Per-thread degree arrays over edge chunks, merged at the end.
+        let chunk = g.connections.len().div_ceil(threads);
+        let partials: Vec<(Vec<u32>, Vec<u32>)> = std::thread::scope(|s| {
+            let handles: Vec<_> = g
+                .connections
+                .chunks(chunk)
+                .map(|conns| s.spawn(|| count_chunk(conns)))
+                .collect();
+            handles.into_iter().map(|h| h.join().expect("metrics worker panicked")).collect()
+        });
+        let mut fan_in = vec![0u32; node_count];
+        let mut fan_out = vec![0u32; node_count];
+        for (fi, fo) in partials {
+            for (acc, v) in fan_in.iter_mut().zip(fi) {
+                *acc += v;
+            }
+            for (acc, v) in fan_out.iter_mut().zip(fo) {
+                *acc += v;
+            }
         }
-    }
+        (fan_in, fan_out)
+    };
+
+    let sum_in: usize = fan_in.iter().map(|&v| v as usize).sum();
+    let sum_out: usize = fan_out.iter().map(|&v| v as usize).sum();
+    let max_in = fan_in.iter().copied().max().unwrap_or(0) as usize;
+    let max_out = fan_out.iter().copied().max().unwrap_or(0) as usize;
 
     let denom = node_count.max(1) as f64; // avoid div-by-zero
     GraphMetrics {
@@ -77,6 +105,34 @@ pub fn compute_metrics(g: &nir::Graph) -> GraphMetrics {
     }
 }
 
+type MemoEntry = (Weak<nir::AdjacencyIndex>, GraphMetrics);
+
+static METRICS_MEMO: OnceLock<Mutex<HashMap<usize, MemoEntry>>> = OnceLock::new();
+
+/// Memoized [`compute_metrics`], keyed on the identity of the graph's cached
+/// adjacency index. Topology edits drop that cache (`invalidate_adjacency`,
+/// clone), taking the memo entry with them, so repeated planning against an
+/// unchanged graph is a map lookup while edits still recompute. The weak
+/// handle guards against a later allocation reusing the same address.
+pub fn metrics_for(g: &nir::Graph) -> GraphMetrics {
+    let adj = g.adjacency();
+    let key = Arc::as_ptr(&adj) as usize;
+    let memo = METRICS_MEMO.get_or_init(|| Mutex::new(HashMap::new()));
+    {
+        let map = memo.lock().expect("metrics memo poisoned");
+        if let Some((weak, m)) = map.get(&key) {
+            if weak.upgrade().is_some_and(|a| Arc::ptr_eq(&a, &adj)) {
+                return m.clone();
+            }
+        }
+    }
+    let m = compute_metrics(g);
+    let mut map = memo.lock().expect("metrics memo poisoned");
+    map.retain(|_, (weak, _)| weak.strong_count() > 0);
+    map.insert(key, (Arc::downgrade(&adj), m.clone()));
+    m
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -114,6 +170,58 @@ mod tests {
         assert_eq!(m.max_fanin, 1);
     }
 
+    #[test]
+    fn parallel_edge_chunks_match_serial_counts() {
+        // Enough edges to cross PARALLEL_EDGE_THRESHOLD and exercise the
+        // chunked path; the counts are trivially checkable.
+        let mut g = nir::Graph::new("wide");
+        for name in ["a", "b"] {
+            g.populations.push(nir::Population {
+                name: name.into(),
+                size: 1,
+                model: "LIF".into(),
+                params: serde_json::json!({}),
+            });
+        }
+        let edges = super::PARALLEL_EDGE_THRESHOLD + 123;
+        for _ in 0..edges {
+            g.connections.push(nir::Connection {
+                pre: "a".into(),
+                post: "b".into(),
+                weight: 0.1,
+                delay_ms: 0.0,
+                plasticity: None,
+                synapses: None,
+            });
+        }
+        let m = compute_metrics(&g);
+        assert_eq!(m.edge_count, edges);
+        assert_eq!(m.max_fanout, edges);
+        assert_eq!(m.max_fanin, edges);
+        assert!(approx_eq(m.avg_fanin, edges as f64 / 2.0));
+    }
+
+    #[test]
+    fn metrics_for_memoizes_until_topology_edit() {
+        let mut g = nir::fixtures::chain(&[4, 4, 4]);
+        let m1 = metrics_for(&g);
+        assert_eq!(m1, compute_metrics(&g));
+        // Unchanged graph: the memo hit returns identical metrics.
+        assert_eq!(metrics_for(&g), m1);
+        // A topology edit invalidates the adjacency, and with it the memo.
+        g.connections.push(nir::Connection {
+            pre: "p0".into(),
+            post: "p2".into(),
+            weight: 0.5,
+            delay_ms: 0.0,
+            plasticity: None,
+            synapses: None,
+        });
+        g.invalidate_adjacency();
+        let m2 = metrics_for(&g);
+        assert_eq!(m2.edge_count, m1.edge_count + 1);
+    }
+
     #[test]
     fn metrics_on_empty_graph_is_safe() {
         let g = nir::Graph::new("empty");
@@ -0,0 +1,493 @@
+//! Multilevel population-graph partitioner.
+//!
+//! Classic three-phase scheme: coarsen the population graph by heavy-edge
+//! matching, compute a balanced initial partition on the coarsest level, then
+//! project back level by level applying FM-style positive-gain refinement.
+//! The objective is weighted edge cut — cross-part spike traffic — subject to
+//! the `max_neurons_per_core` / `max_synapses_per_core` capacities a target
+//! manifest advertises (see `nc_hal::Capabilities`).
+//!
+//! Edge weights approximate traffic: each connection contributes its pre
+//! population size (events per step scale with source neurons). Synapse
+//! capacity is accounted per connection, matching how the mapping passes
+//! count synapses elsewhere.
+
+use crate::{nir, PartitionBuilder, PartitionPlan};
+
+/// `PartitionBuilder` that minimizes weighted edge cut via multilevel
+/// coarsening and refinement. Deterministic for a given seed and graph.
+#[derive(Debug, Clone)]
+pub struct MultilevelBuilder {
+    pub seed: u64,
+    /// Hard neuron capacity per part; `None` means balance-only.
+    pub max_neurons_per_core: Option<usize>,
+    /// Hard synapse (connection) capacity per part; `None` means balance-only.
+    pub max_synapses_per_core: Option<usize>,
+}
+
+impl MultilevelBuilder {
+    pub fn new(seed: u64) -> Self {
+        Self { seed, max_neurons_per_core: None, max_synapses_per_core: None }
+    }
+
+    pub fn with_capacities(
+        mut self,
+        max_neurons_per_core: Option<usize>,
+        max_synapses_per_core: Option<usize>,
+    ) -> Self {
+        self.max_neurons_per_core = max_neurons_per_core;
+        self.max_synapses_per_core = max_synapses_per_core;
+        self
+    }
+}
+
+/// One level of the coarsening hierarchy: an undirected weighted graph with
+/// per-node neuron and synapse loads.
+struct Level {
+    node_w: Vec<u64>,
+    node_syn: Vec<u64>,
+    adj: Vec<Vec<(u32, u64)>>,
+}
+
+impl Level {
+    fn len(&self) -> usize {
+        self.node_w.len()
+    }
+}
+
+fn xorshift64(state: &mut u64) -> u64 {
+    let mut x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    x
+}
+
+fn shuffle(order: &mut [u32], state: &mut u64) {
+    for i in (1..order.len()).rev() {
+        let j = (xorshift64(state) % (i as u64 + 1)) as usize;
+        order.swap(i, j);
+    }
+}
+
+/// Build the base level from a NIR graph using its interned adjacency index.
+/// Parallel and reciprocal connections between the same pair are folded into
+/// one undirected edge; unresolved endpoints and self loops are skipped.
+fn base_level(g: &nir::Graph) -> Level {
+    let adj = g.adjacency();
+    let n = adj.num_populations();
+    let mut node_w = vec![0u64; n];
+    let mut node_syn = vec![0u64; n];
+    for (i, p) in g.populations.iter().enumerate() {
+        node_w[i] = p.size as u64;
+    }
+    let mut pair_w: std::collections::HashMap<(u32, u32), u64> = std::collections::HashMap::new();
+    for pre in 0..n as u32 {
+        node_syn[pre as usize] = adj.out_degree(pre) as u64;
+        let w = std::cmp::max(node_w[pre as usize], 1);
+        for &post in adj.out_edges(pre) {
+            if post == u32::MAX || post == pre {
+                continue;
+            }
+            let key = if pre < post { (pre, post) } else { (post, pre) };
+            *pair_w.entry(key).or_insert(0) += w;
+        }
+    }
+    let mut edges = vec![Vec::new(); n];
+    for (&(a, b), &w) in &pair_w {
+        edges[a as usize].push((b, w));
+        edges[b as usize].push((a, w));
+    }
+    // Deterministic iteration order for matching and refinement.
+    for e in &mut edges {
+        e.sort_unstable();
+    }
+    Level { node_w, node_syn, adj: edges }
+}
+
+/// Heavy-edge matching: visit nodes in shuffled order and merge each with its
+/// heaviest still-unmatched neighbor. Returns the coarse level and the map
+/// from fine node to coarse node.
+fn coarsen(level: &Level, state: &mut u64) -> (Level, Vec<u32>) {
+    let n = level.len();
+    let mut order: Vec<u32> = (0..n as u32).collect();
+    shuffle(&mut order, state);
+    let mut coarse_of = vec![u32::MAX; n];
+    let mut next = 0u32;
+    for &u in &order {
+        if coarse_of[u as usize] != u32::MAX {
+            continue;
+        }
+        let mut best: Option<(u32, u64)> = None;
+        for &(v, w) in &level.adj[u as usize] {
+            if coarse_of[v as usize] == u32::MAX && best.is_none_or(|(_, bw)| w > bw) {
+                best = Some((v, w));
+            }
+        }
+        coarse_of[u as usize] = next;
+        if let Some((v, _)) = best {
+            coarse_of[v as usize] = next;
+        }
+        next += 1;
+    }
+    let cn = next as usize;
+    let mut node_w = vec![0u64; cn];
+    let mut node_syn = vec![0u64; cn];
+    for (u, &c) in coarse_of.iter().enumerate() {
+        node_w[c as usize] += level.node_w[u];
+        node_syn[c as usize] += level.node_syn[u];
+    }
+    let mut pair_w: std::collections::HashMap<(u32, u32), u64> = std::collections::HashMap::new();
+    for u in 0..n {
+        let cu = coarse_of[u];
+        for &(v, w) in &level.adj[u] {
+            let cv = coarse_of[v as usize];
+            if cu >= cv {
+                continue;
+            }
+            *pair_w.entry((cu, cv)).or_insert(0) += w;
+        }
+    }
+    let mut edges = vec![Vec::new(); cn];
+    for (&(a, b), &w) in &pair_w {
+        edges[a as usize].push((b, w));
+        edges[b as usize].push((a, w));
+    }
+    for e in &mut edges {
+        e.sort_unstable();
+    }
+    (Level { node_w, node_syn, adj: edges }, coarse_of)
+}
+
+/// Greedy graph growing: seed each part at an unassigned node and repeatedly
+/// absorb the unassigned node most strongly connected to the region until the
+/// part reaches its target weight or capacity. The last part takes whatever
+/// remains. Keeps tightly coupled nodes together so refinement starts from a
+/// low-cut seed instead of an interleaved one.
+fn initial_partition(level: &Level, parts: usize, limit_n: u64, limit_s: u64) -> Vec<u32> {
+    let n = level.len();
+    let total_w: u64 = level.node_w.iter().sum();
+    let target_w = total_w.div_ceil(parts as u64);
+    let mut part = vec![0u32; n];
+    let mut assigned = vec![false; n];
+    let mut load_n = vec![0u64; parts];
+    let mut load_s = vec![0u64; parts];
+    // Connection weight of each unassigned node into the region being grown.
+    let mut gain = vec![0u64; n];
+    for p in 0..parts {
+        let Some(seed) = (0..n).find(|&u| !assigned[u]) else { break };
+        gain.iter_mut().for_each(|g| *g = 0);
+        let mut next = Some(seed);
+        while let Some(u) = next {
+            if load_n[p] + level.node_w[u] > limit_n || load_s[p] + level.node_syn[u] > limit_s {
+                break;
+            }
+            part[u] = p as u32;
+            assigned[u] = true;
+            load_n[p] += level.node_w[u];
+            load_s[p] += level.node_syn[u];
+            if load_n[p] >= target_w {
+                break;
+            }
+            for &(v, w) in &level.adj[u] {
+                if !assigned[v as usize] {
+                    gain[v as usize] += w;
+                }
+            }
+            // Strongest attachment first; fall back to any unassigned node so
+            // disconnected components still get placed.
+            next = (0..n)
+                .filter(|&v| !assigned[v])
+                .max_by_key(|&v| (gain[v], std::cmp::Reverse(v)));
+        }
+    }
+    // Anything left over goes to the least-loaded part that still fits, or
+    // the least-loaded part outright when nothing does.
+    for u in 0..n {
+        if assigned[u] {
+            continue;
+        }
+        let (w, s) = (level.node_w[u], level.node_syn[u]);
+        let p = (0..parts)
+            .filter(|&p| load_n[p] + w <= limit_n && load_s[p] + s <= limit_s)
+            .min_by_key(|&p| load_n[p])
+            .or_else(|| (0..parts).min_by_key(|&p| load_n[p]))
+            .unwrap_or(0);
+        part[u] = p as u32;
+        load_n[p] += w;
+        load_s[p] += s;
+    }
+    part
+}
+
+/// FM-style refinement sweeps: move a node to the neighboring part with the
+/// largest positive cut gain whenever the move keeps both loads within their
+/// limits. Stops when a full sweep makes no move.
+fn refine(level: &Level, part: &mut [u32], parts: usize, limit_n: u64, limit_s: u64) {
+    const MAX_SWEEPS: usize = 4;
+    let n = level.len();
+    let mut load_n = vec![0u64; parts];
+    let mut load_s = vec![0u64; parts];
+    for u in 0..n {
+        load_n[part[u] as usize] += level.node_w[u];
+        load_s[part[u] as usize] += level.node_syn[u];
+    }
+    let mut conn = vec![0u64; parts];
+    for _ in 0..MAX_SWEEPS {
+        let mut moved = false;
+        for u in 0..n {
+            if level.adj[u].is_empty() {
+                continue;
+            }
+            let cur = part[u] as usize;
+            conn.iter_mut().for_each(|c| *c = 0);
+            for &(v, w) in &level.adj[u] {
+                conn[part[v as usize] as usize] += w;
+            }
+            let (w, s) = (level.node_w[u], level.node_syn[u]);
+            let mut best: Option<(usize, u64)> = None;
+            for t in 0..parts {
+                if t == cur || conn[t] <= conn[cur] {
+                    continue;
+                }
+                if load_n[t] + w > limit_n || load_s[t] + s > limit_s {
+                    continue;
+                }
+                if best.is_none_or(|(_, bc)| conn[t] > bc) {
+                    best = Some((t, conn[t]));
+                }
+            }
+            if let Some((t, _)) = best {
+                load_n[cur] -= w;
+                load_s[cur] -= s;
+                load_n[t] += w;
+                load_s[t] += s;
+                part[u] = t as u32;
+                moved = true;
+            }
+        }
+        if !moved {
+            break;
+        }
+    }
+}
+
+impl PartitionBuilder for MultilevelBuilder {
+    fn plan(&mut self, g: &nir::Graph, _targets: &[&str]) -> PartitionPlan {
+        let n = g.populations.len();
+        if n == 0 {
+            return PartitionPlan { parts: 1, assignment: Vec::new() };
+        }
+
+        let total_n: u64 = g.populations.iter().map(|p| p.size as u64).sum();
+        let total_s = g.connections.len() as u64;
+        let mut parts: usize = 1;
+        if let Some(c) = self.max_neurons_per_core {
+            parts = parts.max((total_n as usize).div_ceil(c.max(1)));
+        }
+        if let Some(c) = self.max_synapses_per_core {
+            parts = parts.max((total_s as usize).div_ceil(c.max(1)));
+        }
+        if self.max_neurons_per_core.is_none() && self.max_synapses_per_core.is_none() {
+            // Historical coarse default when no capacities constrain the plan.
+            parts = std::cmp::min(n, 4);
+        }
+        parts = parts.clamp(1, n);
+
+        let base = base_level(g);
+        if parts == 1 {
+            let assignment = g.populations.iter().map(|p| (p.name.clone(), 0usize)).collect();
+            return PartitionPlan { parts: 1, assignment };
+        }
+
+        // Coarsen until the graph is small relative to the part count or
+        // matching stops making progress.
+        let mut state = self.seed | 1;
+        let mut levels: Vec<(Level, Vec<u32>)> = Vec::new();
+        let mut current = base;
+        let floor = std::cmp::max(parts * 8, 32);
+        while current.len() > floor {
+            let (coarse, coarse_of) = coarsen(&current, &mut state);
+            let shrank = coarse.len() * 10 <= current.len() * 9;
+            let done = !shrank;
+            levels.push((current, coarse_of));
+            current = coarse;
+            if done {
+                break;
+            }
+        }
+        let coarsest = current;
+
+        // Capacity limits, relaxed so a single oversized population (recorded
+        // as a violation upstream) still lands somewhere deterministic.
+        let max_node_w = coarsest.node_w.iter().copied().max().unwrap_or(1);
+        let max_node_s = coarsest.node_syn.iter().copied().max().unwrap_or(0);
+        let limit_s = self
+            .max_synapses_per_core
+            .map(|c| c as u64)
+            .unwrap_or(u64::MAX)
+            .max(max_node_s);
+
+        // The capacity-derived part count is a lower bound; exact packing at
+        // that count may be infeasible, so add parts until the hard neuron
+        // cap holds (or every population has its own part).
+        let mut part;
+        loop {
+            let balance_n = (total_n * 11).div_ceil(10 * parts as u64);
+            let limit_n = self
+                .max_neurons_per_core
+                .map(|c| c as u64)
+                .unwrap_or(balance_n)
+                .max(max_node_w);
+
+            part = initial_partition(&coarsest, parts, limit_n, limit_s);
+            refine(&coarsest, &mut part, parts, limit_n, limit_s);
+
+            // Project back through the hierarchy, refining at every level.
+            for (fine, coarse_of) in levels.iter().rev() {
+                let mut fine_part = vec![0u32; fine.len()];
+                for u in 0..fine.len() {
+                    fine_part[u] = part[coarse_of[u] as usize];
+                }
+                part = fine_part;
+                refine(fine, &mut part, parts, limit_n, limit_s);
+            }
+
+            let mut load_n = vec![0u64; parts];
+            let base_w = levels.first().map(|(l, _)| &l.node_w).unwrap_or(&coarsest.node_w);
+            for (u, &p) in part.iter().enumerate() {
+                load_n[p as usize] += base_w[u];
+            }
+            if parts >= n || load_n.iter().all(|&l| l <= limit_n) {
+                break;
+            }
+            parts += 1;
+        }
+
+        let assignment = g
+            .populations
+            .iter()
+            .enumerate()
+            .map(|(i, p)| (p.name.clone(), part[i] as usize))
+            .collect();
+        PartitionPlan { parts, assignment }
+    }
+}
+
+/// Weighted edge cut of an assignment: sum of undirected edge weights whose
+/// endpoints land in different parts. Exposed for tests and diagnostics.
+pub fn edge_cut(g: &nir::Graph, assignment: &[(String, usize)]) -> u64 {
+    let part: std::collections::HashMap<&str, usize> =
+        assignment.iter().map(|(n, p)| (n.as_str(), *p)).collect();
+    let mut cut = 0u64;
+    for c in &g.connections {
+        let (Some(&a), Some(&b)) = (part.get(c.pre.as_str()), part.get(c.post.as_str())) else {
+            continue;
+        };
+        if a != b {
+            let w = g
+                .populations
+                .iter()
+                .find(|p| p.name == c.pre)
+                .map(|p| p.size as u64)
+                .unwrap_or(1);
+            cut += std::cmp::max(w, 1);
+        }
+    }
+    cut
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn conn(pre: &str, post: &str) -> nir::Connection {
+        nir::Connection {
+            pre: pre.into(),
+            post: post.into(),
+            weight: 1.0,
+            delay_ms: 1.0,
+            plasticity: None,
+            synapses: None,
+        }
+    }
+
+    /// Two dense clusters joined by one weak bridge; capacity forces 2 parts.
+    fn bridged_clusters() -> nir::Graph {
+        let mut g = nir::Graph::new("bridged");
+        for name in ["a0", "a1", "a2", "b0", "b1", "b2"] {
+            g.populations.push(nir::Population {
+                name: name.into(),
+                size: 10,
+                model: "LIF".into(),
+                params: serde_json::json!({}),
+            });
+        }
+        for (x, y) in [("a0", "a1"), ("a1", "a2"), ("a2", "a0"), ("b0", "b1"), ("b1", "b2"), ("b2", "b0")] {
+            g.connections.push(conn(x, y));
+            g.connections.push(conn(y, x));
+        }
+        g.connections.push(conn("a2", "b0"));
+        g
+    }
+
+    #[test]
+    fn multilevel_splits_along_weak_bridge() {
+        let g = bridged_clusters();
+        let mut b = MultilevelBuilder::new(7).with_capacities(Some(30), None);
+        let plan = b.plan(&g, &[]);
+        assert_eq!(plan.parts, 2);
+        let part: std::collections::HashMap<_, _> = plan.assignment.iter().cloned().collect();
+        assert_eq!(part["a0"], part["a1"]);
+        assert_eq!(part["a1"], part["a2"]);
+        assert_eq!(part["b0"], part["b1"]);
+        assert_eq!(part["b1"], part["b2"]);
+        assert_ne!(part["a0"], part["b0"]);
+        // Only the bridge is cut.
+        assert_eq!(edge_cut(&g, &plan.assignment), 10);
+    }
+
+    #[test]
+    fn multilevel_deterministic_for_seed() {
+        let g = bridged_clusters();
+        let p1 = MultilevelBuilder::new(42).with_capacities(Some(30), None).plan(&g, &[]);
+        let p2 = MultilevelBuilder::new(42).with_capacities(Some(30), None).plan(&g, &[]);
+        assert_eq!(p1, p2);
+    }
+
+    #[test]
+    fn multilevel_respects_neuron_capacity() {
+        let sizes: Vec<u32> = (0..16).map(|i| 4 + (i % 5)).collect();
+        let g = nir::fixtures::chain(&sizes);
+        let cap = 24usize;
+        let mut b = MultilevelBuilder::new(3).with_capacities(Some(cap), None);
+        let plan = b.plan(&g, &[]);
+        let mut load = vec![0u64; plan.parts];
+        let by_name: std::collections::HashMap<_, _> =
+            g.populations.iter().map(|p| (p.name.as_str(), p.size as u64)).collect();
+        for (name, part) in &plan.assignment {
+            load[*part] += by_name[name.as_str()];
+        }
+        for l in load {
+            assert!(l <= cap as u64, "part load {} exceeds capacity {}", l, cap);
+        }
+    }
+
+    #[test]
+    fn multilevel_cut_no_worse_than_chunked_assignment() {
+        let g = nir::fixtures::ring(12, 8, 1.0, 1.0);
+        let mut b = MultilevelBuilder::new(11).with_capacities(Some(32), None);
+        let plan = b.plan(&g, &[]);
+        // Index-order chunking cuts the ring at every part boundary; the
+        // multilevel plan should never do worse.
+        let chunk = g.populations.len().div_ceil(plan.parts);
+        let naive: Vec<(String, usize)> = g
+            .populations
+            .iter()
+            .enumerate()
+            .map(|(i, p)| (p.name.clone(), i / chunk))
+            .collect();
+        assert!(edge_cut(&g, &plan.assignment) <= edge_cut(&g, &naive));
+    }
+}
@@ -0,0 +1,44 @@
+use criterion::{criterion_group, criterion_main, BatchSize, BenchmarkId, Criterion};
+use nc_passes::nir;
+use nc_passes::{build_pipeline, PassManager, PipelineConfig};
+
+/// Validation-clean uniform-degree graph with roughly `edges` connections.
+fn synth_graph(edges: usize) -> nir::Graph {
+    let cfg = nir::generate::GeneratorConfig {
+        populations: std::cmp::max(edges / 64, 2) as u32,
+        degree: nir::generate::DegreeDistribution::Uniform { out_degree: 64 },
+        ..Default::default()
+    };
+    nir::generate::build(&cfg)
+}
+
+fn bench_full_pipeline(c: &mut Criterion) {
+    let names: Vec<String> = ["validate", "quantize8", "partition", "placement"]
+        .iter()
+        .map(|s| s.to_string())
+        .collect();
+    let mut pm = PassManager::new();
+    build_pipeline(&mut pm, &names).unwrap();
+    let cfg = PipelineConfig { passes: names, dump_dir: None, dump_formats: Vec::new(), cache: false };
+
+    let mut group = c.benchmark_group("passes_pipeline/validate_quantize8_partition_placement");
+    group.sample_size(10);
+    for &edges in &[10_000usize, 100_000, 1_000_000] {
+        let g = synth_graph(edges);
+        group.bench_with_input(BenchmarkId::from_parameter(edges), &g, |b, g| {
+            b.iter_batched(
+                || g.clone(),
+                |g| pm.run_with_config(g, &cfg).unwrap(),
+                BatchSize::LargeInput,
+            )
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(
+    name = pipeline_benches;
+    config = Criterion::default();
+    targets = bench_full_pipeline
+);
+criterion_main!(pipeline_benches);
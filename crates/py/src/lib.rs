@@ -24,25 +24,26 @@ pub fn compile_stub(target: &str) -> Result<String> {
     Ok(format!("compile: target={target}"))
 }
 
-/// Compile NIR from JSON string for a specific target (feature-gated backends).
-pub fn compile_nir_json_str(target: &str, json: &str) -> Result<String> {
-    let mut g = nc_nir::Graph::from_json_str(json)?;
+/// Compile an already constructed graph for a specific target (feature-gated
+/// backends). Validation and version tagging happen here, so bulk-built
+/// graphs (see [`build_graph_from_arrays`]) skip the JSON round trip.
+pub fn compile_graph(target: &str, mut g: nc_nir::Graph) -> Result<String> {
     g.validate().map_err(|e| anyhow::anyhow!(e.to_string()))?;
     g.ensure_version_tag();
     let manifest_path = std::path::PathBuf::from(format!("targets/{target}.toml"));
-    let manifest = nc_hal::parse_target_manifest_path(&manifest_path)?;
-    nc_hal::validate_manifest(&manifest)?;
+    let manifest = nc_hal::manifest_for_path(&manifest_path)?;
+    let _ = &manifest; // used only by enabled backend branches
 
     match target {
         "truenorth" => {
             #[cfg(feature = "backend-truenorth")]
-            { return nc_backend_truenorth::compile(&g, &manifest); }
+            { nc_backend_truenorth::compile(&g, &manifest) }
             #[cfg(not(feature = "backend-truenorth"))]
             { anyhow::bail!("backend 'truenorth' not enabled; build python crate with feature 'backend-truenorth'"); }
         }
         "dynaps" => {
             #[cfg(feature = "backend-dynaps")]
-            { return nc_backend_dynaps::compile(&g, &manifest); }
+            { nc_backend_dynaps::compile(&g, &manifest) }
             #[cfg(not(feature = "backend-dynaps"))]
             { anyhow::bail!("backend 'dynaps' not enabled; build python crate with feature 'backend-dynaps'"); }
         }
@@ -52,7 +53,7 @@ pub fn compile_nir_json_str(target: &str, json: &str) -> Result<String> {
         //   NC_RISCV_QEMU_RUN=0  -> compile-only (unit tests use this)
         "riscv64gcv_linux" | "riscv32imac_bare" | "riscv64gc_ctrl" => {
             #[cfg(feature = "backend-riscv")]
-            { return nc_backend_riscv::compile(&g, &manifest); }
+            { nc_backend_riscv::compile(&g, &manifest) }
             #[cfg(not(feature = "backend-riscv"))]
             { anyhow::bail!("backend 'riscv' not enabled; build python crate with feature 'backend-riscv'"); }
         }
@@ -60,40 +61,135 @@ pub fn compile_nir_json_str(target: &str, json: &str) -> Result<String> {
     }
 }
 
+/// Compile NIR from JSON string for a specific target (feature-gated backends).
+pub fn compile_nir_json_str(target: &str, json: &str) -> Result<String> {
+    compile_graph(target, nc_nir::Graph::from_json_str(json)?)
+}
+
 /// Compile NIR from YAML string for a specific target (feature-gated backends).
 pub fn compile_nir_yaml_str(target: &str, yaml: &str) -> Result<String> {
-    let mut g = nc_nir::Graph::from_yaml_str(yaml)?;
-    g.validate().map_err(|e| anyhow::anyhow!(e.to_string()))?;
-    g.ensure_version_tag();
-    let manifest_path = std::path::PathBuf::from(format!("targets/{target}.toml"));
-    let manifest = nc_hal::parse_target_manifest_path(&manifest_path)?;
-    nc_hal::validate_manifest(&manifest)?;
+    compile_graph(target, nc_nir::Graph::from_yaml_str(yaml)?)
+}
 
-    match target {
-        "truenorth" => {
-            #[cfg(feature = "backend-truenorth")]
-            { return nc_backend_truenorth::compile(&g, &manifest); }
-            #[cfg(not(feature = "backend-truenorth"))]
-            { anyhow::bail!("backend 'truenorth' not enabled; build python crate with feature 'backend-truenorth'"); }
+/// Build a graph in bulk from contiguous arrays: population `i` is named
+/// `p{i}` with `sizes[i]` neurons, and `pre`/`post`/`weights`/`delays_ms` are
+/// parallel per-connection planes of population indices. The Python bindings
+/// call this on borrowed NumPy buffers so graph construction is one pass over
+/// the slices instead of per-element FFI traffic.
+pub fn build_graph_from_arrays(
+    name: &str,
+    sizes: &[u32],
+    pre: &[u32],
+    post: &[u32],
+    weights: &[f32],
+    delays_ms: &[f32],
+) -> Result<nc_nir::Graph> {
+    if pre.len() != post.len() || pre.len() != weights.len() || pre.len() != delays_ms.len() {
+        anyhow::bail!(
+            "pre/post/weights/delays_ms lengths differ: {}/{}/{}/{}",
+            pre.len(), post.len(), weights.len(), delays_ms.len()
+        );
+    }
+    let mut g = nc_nir::Graph::new(name);
+    g.populations.reserve_exact(sizes.len());
+    for (i, &size) in sizes.iter().enumerate() {
+        g.populations.push(nc_nir::Population {
+            name: format!("p{i}"),
+            size,
+            model: "lif".to_string(),
+            params: serde_json::json!({}),
+        });
+    }
+    let n = sizes.len() as u32;
+    g.connections.reserve_exact(pre.len());
+    for i in 0..pre.len() {
+        if pre[i] >= n || post[i] >= n {
+            anyhow::bail!("connection #{i} references population {}/{}, only {n} exist", pre[i], post[i]);
         }
-        "dynaps" => {
-            #[cfg(feature = "backend-dynaps")]
-            { return nc_backend_dynaps::compile(&g, &manifest); }
-            #[cfg(not(feature = "backend-dynaps"))]
-            { anyhow::bail!("backend 'dynaps' not enabled; build python crate with feature 'backend-dynaps'"); }
+        g.connections.push(nc_nir::Connection {
+            pre: format!("p{}", pre[i]),
+            post: format!("p{}", post[i]),
+            weight: weights[i],
+            delay_ms: delays_ms[i],
+            plasticity: None,
+            synapses: None,
+        });
+    }
+    Ok(g)
+}
+
+/// Assemble a CSR [`nc_nir::SynapseMatrix`] from COO triplets in one counting
+/// pass over the planes (no per-synapse allocation), validating indices
+/// against the endpoint population sizes.
+pub fn synapse_matrix_from_coo(
+    pre_size: u32,
+    post_size: u32,
+    pre_idx: &[u32],
+    post_idx: &[u32],
+    weights: &[f32],
+) -> Result<nc_nir::SynapseMatrix> {
+    if pre_idx.len() != post_idx.len() || pre_idx.len() != weights.len() {
+        anyhow::bail!(
+            "pre_idx/post_idx/weights lengths differ: {}/{}/{}",
+            pre_idx.len(), post_idx.len(), weights.len()
+        );
+    }
+    let nnz = weights.len();
+    let mut row_ptr = vec![0u32; pre_size as usize + 1];
+    for (i, &r) in pre_idx.iter().enumerate() {
+        if r >= pre_size {
+            anyhow::bail!("synapse #{i} pre neuron {r} out of range (pre_size={pre_size})");
         }
-        // RISC-V targets (compile-only from Python by default).
-        // Runtime execution via QEMU/Renode is controlled out-of-process with env:
-        //   NC_RISCV_QEMU_RUN=1  -> attempt run if toolchains are present
-        //   NC_RISCV_QEMU_RUN=0  -> compile-only (unit tests use this)
-        "riscv64gcv_linux" | "riscv32imac_bare" | "riscv64gc_ctrl" => {
-            #[cfg(feature = "backend-riscv")]
-            { return nc_backend_riscv::compile(&g, &manifest); }
-            #[cfg(not(feature = "backend-riscv"))]
-            { anyhow::bail!("backend 'riscv' not enabled; build python crate with feature 'backend-riscv'"); }
+        row_ptr[r as usize + 1] += 1;
+    }
+    for i in 1..row_ptr.len() {
+        row_ptr[i] += row_ptr[i - 1];
+    }
+    let mut col_idx = vec![0u32; nnz];
+    let mut w = vec![0.0f32; nnz];
+    let mut cursor: Vec<u32> = row_ptr[..pre_size as usize].to_vec();
+    for i in 0..nnz {
+        let c = post_idx[i];
+        if c >= post_size {
+            anyhow::bail!("synapse #{i} post neuron {c} out of range (post_size={post_size})");
         }
-        other => anyhow::bail!("unsupported target '{other}'"),
+        let slot = cursor[pre_idx[i] as usize] as usize;
+        col_idx[slot] = c;
+        w[slot] = weights[i];
+        cursor[pre_idx[i] as usize] += 1;
     }
+    let m = nc_nir::SynapseMatrix { row_ptr, col_idx, weights: w };
+    m.check_dims(pre_size, post_size)
+        .map_err(|e| anyhow::anyhow!(e))?;
+    Ok(m)
+}
+
+/// Attach a sparse synapse block built from COO planes to `g` as a new
+/// connection between two existing populations.
+pub fn add_sparse_connection(
+    g: &mut nc_nir::Graph,
+    pre: &str,
+    post: &str,
+    pre_idx: &[u32],
+    post_idx: &[u32],
+    weights: &[f32],
+) -> Result<()> {
+    let pre_size = g.populations.iter().find(|p| p.name == pre)
+        .map(|p| p.size)
+        .ok_or_else(|| anyhow::anyhow!("unknown pre population '{pre}'"))?;
+    let post_size = g.populations.iter().find(|p| p.name == post)
+        .map(|p| p.size)
+        .ok_or_else(|| anyhow::anyhow!("unknown post population '{post}'"))?;
+    let m = synapse_matrix_from_coo(pre_size, post_size, pre_idx, post_idx, weights)?;
+    g.connections.push(nc_nir::Connection {
+        pre: pre.to_string(),
+        post: post.to_string(),
+        weight: 1.0,
+        delay_ms: 0.0,
+        plasticity: None,
+        synapses: Some(m),
+    });
+    Ok(())
 }
 
 /// Compile NIR from a string (auto-detect JSON vs YAML) for a specific target.
@@ -322,9 +418,157 @@ pub fn deploy_stub(target: &str) -> Result<String> {
 #[cfg(feature = "python")]
 use pyo3::prelude::*;
 
+/// Graph handle exposed to Python. Construction methods accept NumPy arrays
+/// and operate on the borrowed buffers directly — no per-element Python
+/// object conversion — releasing the GIL while the Rust side builds the
+/// populations, connections, or CSR synapse planes.
+#[cfg(feature = "python")]
+#[pyclass(name = "Graph")]
+struct PyGraph {
+    inner: nc_nir::Graph,
+}
+
+#[cfg(feature = "python")]
+#[pymethods]
+impl PyGraph {
+    #[new]
+    fn new(name: &str) -> Self {
+        Self { inner: nc_nir::Graph::new(name) }
+    }
+
+    #[getter]
+    fn name(&self) -> String {
+        self.inner.name.clone()
+    }
+
+    fn num_populations(&self) -> usize {
+        self.inner.populations.len()
+    }
+
+    fn num_connections(&self) -> usize {
+        self.inner.connections.len()
+    }
+
+    /// Append populations `p{offset}..` in bulk, one per entry of `sizes`.
+    fn add_populations(&mut self, py: Python<'_>, sizes: numpy::PyReadonlyArray1<'_, u32>) -> PyResult<()> {
+        let sizes = sizes.as_slice()?;
+        let offset = self.inner.populations.len();
+        let pops = py.allow_threads(|| {
+            let mut pops = Vec::with_capacity(sizes.len());
+            for (i, &size) in sizes.iter().enumerate() {
+                pops.push(nc_nir::Population {
+                    name: format!("p{}", offset + i),
+                    size,
+                    model: "lif".to_string(),
+                    params: serde_json::json!({}),
+                });
+            }
+            pops
+        });
+        self.inner.populations.extend(pops);
+        Ok(())
+    }
+
+    /// Append population-level connections in bulk from parallel index and
+    /// weight/delay planes.
+    fn connect(
+        &mut self,
+        py: Python<'_>,
+        pre: numpy::PyReadonlyArray1<'_, u32>,
+        post: numpy::PyReadonlyArray1<'_, u32>,
+        weights: numpy::PyReadonlyArray1<'_, f32>,
+        delays_ms: numpy::PyReadonlyArray1<'_, f32>,
+    ) -> PyResult<()> {
+        let (pre, post) = (pre.as_slice()?, post.as_slice()?);
+        let (weights, delays_ms) = (weights.as_slice()?, delays_ms.as_slice()?);
+        let n = self.inner.populations.len() as u32;
+        let conns = py
+            .allow_threads(|| -> Result<Vec<nc_nir::Connection>> {
+                if pre.len() != post.len() || pre.len() != weights.len() || pre.len() != delays_ms.len() {
+                    anyhow::bail!("pre/post/weights/delays_ms lengths differ");
+                }
+                let mut conns = Vec::with_capacity(pre.len());
+                for i in 0..pre.len() {
+                    if pre[i] >= n || post[i] >= n {
+                        anyhow::bail!("connection #{i} references population {}/{}, only {n} exist", pre[i], post[i]);
+                    }
+                    conns.push(nc_nir::Connection {
+                        pre: format!("p{}", pre[i]),
+                        post: format!("p{}", post[i]),
+                        weight: weights[i],
+                        delay_ms: delays_ms[i],
+                        plasticity: None,
+                        synapses: None,
+                    });
+                }
+                Ok(conns)
+            })
+            .map_err(|e| pyo3::exceptions::PyValueError::new_err(e.to_string()))?;
+        self.inner.connections.extend(conns);
+        Ok(())
+    }
+
+    /// Attach a sparse synapse block between two populations from COO planes
+    /// (per-synapse pre/post neuron indices and weights). The CSR assembly
+    /// runs without the GIL over the borrowed buffers.
+    fn connect_sparse(
+        &mut self,
+        py: Python<'_>,
+        pre: &str,
+        post: &str,
+        pre_idx: numpy::PyReadonlyArray1<'_, u32>,
+        post_idx: numpy::PyReadonlyArray1<'_, u32>,
+        weights: numpy::PyReadonlyArray1<'_, f32>,
+    ) -> PyResult<()> {
+        let (pre_idx, post_idx, weights) = (pre_idx.as_slice()?, post_idx.as_slice()?, weights.as_slice()?);
+        let g = &mut self.inner;
+        py.allow_threads(|| add_sparse_connection(g, pre, post, pre_idx, post_idx, weights))
+            .map_err(|e| pyo3::exceptions::PyValueError::new_err(e.to_string()))
+    }
+
+    fn validate(&self) -> PyResult<()> {
+        self.inner
+            .validate()
+            .map_err(|e| pyo3::exceptions::PyValueError::new_err(e.to_string()))
+    }
+
+    fn to_json(&self) -> PyResult<String> {
+        self.inner
+            .to_json_string()
+            .map_err(|e| pyo3::exceptions::PyRuntimeError::new_err(e.to_string()))
+    }
+
+    /// Compile this graph for a target without a JSON round trip.
+    fn compile(&self, py: Python<'_>, target: &str) -> PyResult<String> {
+        let g = self.inner.clone();
+        py.allow_threads(|| compile_graph(target, g))
+            .map_err(|e| pyo3::exceptions::PyRuntimeError::new_err(e.to_string()))
+    }
+}
+
 #[cfg(feature = "python")]
 #[pymodule]
-fn neuro_compiler(_py: Python, m: &PyModule) -> PyResult<()> {
+fn neuro_compiler(_py: Python, m: &Bound<'_, PyModule>) -> PyResult<()> {
+    m.add_class::<PyGraph>()?;
+    /// One-shot bulk construction from NumPy arrays (see build_graph_from_arrays).
+    #[pyfn(m)]
+    fn graph_from_arrays_py(
+        py: Python<'_>,
+        name: &str,
+        sizes: numpy::PyReadonlyArray1<'_, u32>,
+        pre: numpy::PyReadonlyArray1<'_, u32>,
+        post: numpy::PyReadonlyArray1<'_, u32>,
+        weights: numpy::PyReadonlyArray1<'_, f32>,
+        delays_ms: numpy::PyReadonlyArray1<'_, f32>,
+    ) -> PyResult<PyGraph> {
+        let sizes = sizes.as_slice()?;
+        let (pre, post) = (pre.as_slice()?, post.as_slice()?);
+        let (weights, delays_ms) = (weights.as_slice()?, delays_ms.as_slice()?);
+        let g = py
+            .allow_threads(|| build_graph_from_arrays(name, sizes, pre, post, weights, delays_ms))
+            .map_err(|e| pyo3::exceptions::PyValueError::new_err(e.to_string()))?;
+        Ok(PyGraph { inner: g })
+    }
     #[pyfn(m)]
     fn version_py() -> &'static str { version() }
     #[pyfn(m)]
@@ -397,9 +641,9 @@ mod tests {
         let nir = std::fs::read_to_string("examples/nir/simple.json").expect("read NIR");
         pyo3::prepare_freethreaded_python();
         pyo3::Python::with_gil(|py| {
-            let m = pyo3::types::PyModule::new(py, "neuro_compiler").expect("module new");
+            let m = pyo3::types::PyModule::new_bound(py, "neuro_compiler").expect("module new");
             // Initialize the in-process module with all #[pyfn] exports
-            crate::neuro_compiler(py, m).expect("init module");
+            crate::neuro_compiler(py, &m).expect("init module");
             let f = m.getattr("compile_nir_str_py").expect("get compile_nir_str_py");
             let art: String = f.call1(("riscv64gcv_linux", nir.as_str()))
                 .expect("call ok")
@@ -414,6 +658,45 @@ mod tests {
         });
     }
 
+    #[test]
+    fn bulk_graph_from_arrays_builds_and_validates() {
+        let g = build_graph_from_arrays(
+            "bulk",
+            &[4, 8, 2],
+            &[0, 1],
+            &[1, 2],
+            &[0.5, -0.25],
+            &[1.0, 2.0],
+        ).expect("bulk build");
+        assert_eq!(g.populations.len(), 3);
+        assert_eq!(g.connections.len(), 2);
+        assert_eq!(g.connections[0].pre, "p0");
+        assert_eq!(g.connections[1].post, "p2");
+        g.validate().expect("bulk graph valid");
+        assert!(build_graph_from_arrays("bad", &[4], &[0], &[3], &[0.1], &[0.0]).is_err());
+    }
+
+    #[test]
+    fn coo_to_csr_matches_check_dims() {
+        // 2 pre neurons, 3 post neurons, unsorted COO input
+        let m = synapse_matrix_from_coo(2, 3, &[1, 0, 1], &[2, 0, 1], &[0.3, 0.1, 0.2]).expect("csr");
+        assert_eq!(m.row_ptr, vec![0, 1, 3]);
+        assert_eq!(m.col_idx, vec![0, 2, 1]);
+        assert_eq!(m.weights, vec![0.1, 0.3, 0.2]);
+        assert!(synapse_matrix_from_coo(2, 3, &[5], &[0], &[0.1]).is_err());
+        assert!(synapse_matrix_from_coo(2, 3, &[0], &[9], &[0.1]).is_err());
+    }
+
+    #[test]
+    fn sparse_connection_attaches_to_existing_pops() {
+        let mut g = build_graph_from_arrays("sp", &[2, 3], &[], &[], &[], &[]).unwrap();
+        add_sparse_connection(&mut g, "p0", "p1", &[0, 1], &[1, 2], &[0.4, 0.6]).expect("attach");
+        assert_eq!(g.connections.len(), 1);
+        assert_eq!(g.connections[0].synapses.as_ref().map(|m| m.nnz()), Some(2));
+        g.validate().expect("sparse graph valid");
+        assert!(add_sparse_connection(&mut g, "p0", "nope", &[], &[], &[]).is_err());
+    }
+
     // Negative test when RISC-V backend feature is NOT enabled
     #[cfg(not(feature = "backend-riscv"))]
     #[test]
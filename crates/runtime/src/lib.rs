@@ -7,6 +7,11 @@ use std::collections::BTreeMap;
 #[derive(Debug, Clone)]
 pub struct DeploySpec {
     pub target: String,
+    /// Optional NCPK artifact package to unpack for this target; see
+    /// [`package`]. When unset, deploy stays a metadata-only stub.
+    pub package: Option<std::path::PathBuf>,
+    /// Where unpacked members land; defaults to `target/deploy-<target>`.
+    pub dest: Option<std::path::PathBuf>,
 }
 
 #[derive(Debug, Clone)]
@@ -36,6 +41,27 @@ pub fn deploy(_spec: &DeploySpec) -> Result<()> {
         let _ = a.counter("runtime.deploy_requests", 1.0, l);
     }
 
+    // Fast path for packaged artifacts: seek-extract only the members this
+    // target needs (its own subtree plus shared top-level files) instead of
+    // decompressing the whole payload.
+    if let Some(pkg) = &_spec.package {
+        let dest = _spec
+            .dest
+            .clone()
+            .unwrap_or_else(|| std::path::PathBuf::from(format!("target/deploy-{}", _spec.target)));
+        let mut reader = package::PackageReader::open(pkg)?;
+        let prefix = format!("{}/", _spec.target);
+        let extracted = reader.extract_matching(&dest, |p| p.starts_with(&prefix) || !p.contains('/'))?;
+
+        #[cfg(feature = "telemetry")]
+        if let Some(a) = &app {
+            let mut l = BTreeMap::new();
+            l.insert("target".to_string(), _spec.target.clone());
+            let _ = a.counter("runtime.deploy_members", extracted.len() as f64, l);
+        }
+        let _ = extracted;
+    }
+
     Ok(())
 }
 
@@ -76,13 +102,38 @@ mod tests {
     use super::*;
     #[test]
     fn lifecycle_stubs_succeed() {
-        let spec = DeploySpec { target: "riscv64gcv_linux".to_string() };
+        let spec = DeploySpec { target: "riscv64gcv_linux".to_string(), package: None, dest: None };
         deploy(&spec).expect("deploy ok");
         start().expect("start ok");
         stop().expect("stop ok");
         let s = status();
         assert!(!s.running);
     }
+
+    #[test]
+    fn deploy_unpacks_only_the_targets_members() {
+        let pkg = std::env::temp_dir().join("nc_deploy_pkg.ncpk");
+        let dest = std::env::temp_dir().join("nc_deploy_pkg_out");
+        let _ = std::fs::remove_file(&pkg);
+        let _ = std::fs::remove_dir_all(&dest);
+        let mut w = package::PackageWriter::create(&pkg).unwrap();
+        w.add_bytes("riscv64gcv_linux/main.c", b"int main;").unwrap();
+        w.add_bytes("loihi2/core.cfg", b"cfg").unwrap();
+        w.add_bytes("PKG.txt", b"meta").unwrap();
+        w.finish().unwrap();
+
+        let spec = DeploySpec {
+            target: "riscv64gcv_linux".to_string(),
+            package: Some(pkg.clone()),
+            dest: Some(dest.clone()),
+        };
+        deploy(&spec).expect("packaged deploy ok");
+        assert!(dest.join("riscv64gcv_linux/main.c").exists());
+        assert!(dest.join("PKG.txt").exists());
+        assert!(!dest.join("loihi2").exists(), "other targets stay packed");
+        let _ = std::fs::remove_file(&pkg);
+        let _ = std::fs::remove_dir_all(&dest);
+    }
 }
 
 pub mod adaptive {
@@ -90,8 +141,11 @@ pub mod adaptive {
 
     #[cfg(feature = "telemetry")]
     use nc_telemetry as telemetry;
-    use std::collections::HashSet;
+    use std::collections::HashMap;
+    use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+    use std::sync::mpsc::{self, SyncSender, TrySendError};
     use std::sync::{Mutex, OnceLock};
+    use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 
     #[derive(Debug, Clone)]
     pub struct ResourceSnapshot {
@@ -127,6 +181,33 @@ pub mod adaptive {
         }
     }
 
+    /// Watermark policy: throttle when buffers back up, repartition on
+    /// sustained compute pressure, otherwise leave the system alone. Buffer
+    /// pressure wins because dropping work is worse than running hot.
+    pub struct ThresholdPolicy {
+        pub repartition_above_pct: f32,
+        pub throttle_above_pct: f32,
+    }
+
+    impl Default for ThresholdPolicy {
+        fn default() -> Self {
+            Self { repartition_above_pct: 85.0, throttle_above_pct: 90.0 }
+        }
+    }
+
+    impl Policy for ThresholdPolicy {
+        fn name(&self) -> &str { "threshold-policy" }
+        fn decide(&self, snapshot: &ResourceSnapshot) -> Decision {
+            if snapshot.buffer_occupancy_pct >= self.throttle_above_pct {
+                Decision::Throttle
+            } else if snapshot.utilization_pct >= self.repartition_above_pct {
+                Decision::Repartition
+            } else {
+                Decision::NoChange
+            }
+        }
+    }
+
     /// Apply options for runtime decisions.
     #[derive(Debug, Clone, Default)]
     pub struct ApplyOptions {
@@ -156,23 +237,101 @@ pub mod adaptive {
 
     impl std::error::Error for ApplyError {}
 
-    // Simple in-process idempotency registry (thread-safe).
-    static IDEM_REGISTRY: OnceLock<Mutex<HashSet<String>>> = OnceLock::new();
+    const IDEM_SHARDS: usize = 8;
+    /// Keys de-duplicate within the current and previous bucket, then age
+    /// out, so the registry stays bounded instead of growing forever.
+    const IDEM_BUCKET: Duration = Duration::from_secs(300);
 
-    fn idem() -> &'static Mutex<HashSet<String>> {
-        IDEM_REGISTRY.get_or_init(|| Mutex::new(HashSet::new()))
+    /// Sharded, time-bucketed idempotency registry. Sharding spreads lock
+    /// contention across callers; bucketing gives every key a finite
+    /// lifetime (current + previous bucket) with pruning done in passing.
+    struct IdemRegistry {
+        shards: [Mutex<HashMap<String, u64>>; IDEM_SHARDS],
+        bucket: Duration,
+    }
+
+    impl IdemRegistry {
+        fn new(bucket: Duration) -> Self {
+            Self { shards: std::array::from_fn(|_| Mutex::new(HashMap::new())), bucket }
+        }
+
+        fn current_bucket(&self) -> u64 {
+            let now = SystemTime::now().duration_since(UNIX_EPOCH).unwrap_or_default();
+            (now.as_millis() / self.bucket.as_millis().max(1)) as u64
+        }
+
+        fn shard_for(&self, key: &str) -> &Mutex<HashMap<String, u64>> {
+            // FNV-1a; only used to spread keys across shards.
+            let mut h: u64 = 0xcbf2_9ce4_8422_2325;
+            for b in key.bytes() {
+                h ^= b as u64;
+                h = h.wrapping_mul(0x100_0000_01b3);
+            }
+            &self.shards[(h as usize) % IDEM_SHARDS]
+        }
+
+        /// Returns true if the key was seen within the dedup window;
+        /// otherwise records it and returns false.
+        fn register_if_new(&self, key: &str) -> bool {
+            let now = self.current_bucket();
+            let mut map = self.shard_for(key).lock().expect("idempotency shard poisoned");
+            map.retain(|_, stamp| *stamp + 1 >= now);
+            match map.get(key) {
+                Some(stamp) if *stamp + 1 >= now => true,
+                _ => {
+                    map.insert(key.to_string(), now);
+                    false
+                }
+            }
+        }
+    }
+
+    static IDEM_REGISTRY: OnceLock<IdemRegistry> = OnceLock::new();
+
+    fn idem() -> &'static IdemRegistry {
+        IDEM_REGISTRY.get_or_init(|| IdemRegistry::new(IDEM_BUCKET))
     }
 
     /// Returns true if the key has already been seen; otherwise records it and returns false.
     fn register_idem_if_new(key: &str) -> bool {
-        let m = idem();
-        let mut set = m.lock().expect("idempotency mutex poisoned");
-        if set.contains(key) {
-            true
-        } else {
-            set.insert(key.to_string());
-            false
-        }
+        idem().register_if_new(key)
+    }
+
+    // Graph the decisions operate on; set by [`Controller::spawn`] (or
+    // directly via [`set_current_graph`]) so `Repartition` has something to
+    // hand the orchestrator.
+    static CURRENT_GRAPH: OnceLock<Mutex<Option<nc_nir::Graph>>> = OnceLock::new();
+    static LAST_PLAN: OnceLock<Mutex<Option<nc_orchestrator::PartitionPlan>>> = OnceLock::new();
+    static THROTTLE_LEVEL: AtomicU32 = AtomicU32::new(0);
+    static SCHEDULE_EPOCH: AtomicU64 = AtomicU64::new(0);
+
+    fn current_graph() -> &'static Mutex<Option<nc_nir::Graph>> {
+        CURRENT_GRAPH.get_or_init(|| Mutex::new(None))
+    }
+
+    fn last_plan_slot() -> &'static Mutex<Option<nc_orchestrator::PartitionPlan>> {
+        LAST_PLAN.get_or_init(|| Mutex::new(None))
+    }
+
+    /// Install the graph that subsequent `Repartition` decisions act on.
+    pub fn set_current_graph(g: nc_nir::Graph) {
+        *current_graph().lock().expect("current graph mutex poisoned") = Some(g);
+    }
+
+    /// Plan produced by the most recent applied `Repartition`, if any.
+    pub fn last_partition_plan() -> Option<nc_orchestrator::PartitionPlan> {
+        last_plan_slot().lock().expect("partition plan mutex poisoned").clone()
+    }
+
+    /// Current throttle level; each applied `Throttle` raises it by one.
+    pub fn throttle_level() -> u32 {
+        THROTTLE_LEVEL.load(Ordering::Relaxed)
+    }
+
+    /// Monotonic counter bumped by each applied `Reschedule`; executors pick
+    /// up a new ordering when they observe a change.
+    pub fn schedule_epoch() -> u64 {
+        SCHEDULE_EPOCH.load(Ordering::Relaxed)
     }
 
     /// Apply a decision to the running system with options.
@@ -208,15 +367,22 @@ pub mod adaptive {
         match decision {
             Decision::NoChange => Ok(()),
             Decision::Repartition => {
-                // TODO(H2-5): invoke orchestrator handoff and update partition context
+                // Without a current graph there is nothing to repartition and
+                // the decision degrades to a no-op.
+                let guard = current_graph().lock().expect("current graph mutex poisoned");
+                if let Some(g) = guard.as_ref() {
+                    let plan = nc_orchestrator::partition(g, &[])
+                        .map_err(|e| ApplyError::Backend(e.to_string()))?;
+                    *last_plan_slot().lock().expect("partition plan mutex poisoned") = Some(plan);
+                }
                 Ok(())
             }
             Decision::Reschedule => {
-                // TODO(H2-5): integrate scheduler to adjust execution ordering
+                SCHEDULE_EPOCH.fetch_add(1, Ordering::Relaxed);
                 Ok(())
             }
             Decision::Throttle => {
-                // TODO(H2-5): apply rate limiting via backend/runtime shims
+                THROTTLE_LEVEL.fetch_add(1, Ordering::Relaxed);
                 Ok(())
             }
         }
@@ -227,6 +393,110 @@ pub mod adaptive {
         apply_with_options(decision, &ApplyOptions::default())
     }
 
+    /// Tuning for the background control loop.
+    #[derive(Debug, Clone)]
+    pub struct ControllerConfig {
+        /// Capacity of the bounded snapshot queue; producers drop rather
+        /// than block when it is full.
+        pub channel_capacity: usize,
+        /// Consecutive identical decisions required before acting, so a
+        /// single noisy snapshot cannot flip the system back and forth.
+        pub hysteresis: u32,
+        /// Minimum time between applied actions.
+        pub cooldown: Duration,
+    }
+
+    impl Default for ControllerConfig {
+        fn default() -> Self {
+            Self { channel_capacity: 64, hysteresis: 3, cooldown: Duration::from_millis(100) }
+        }
+    }
+
+    /// Summary returned by [`Controller::stop`] after the policy thread drains.
+    #[derive(Debug, Clone, Default)]
+    pub struct ControllerReport {
+        pub snapshots_seen: u64,
+        pub snapshots_dropped: u64,
+        pub applied: Vec<Decision>,
+        /// Part count from the last repartition this loop applied, if any.
+        pub partition_parts: Option<usize>,
+    }
+
+    /// Background control loop: a bounded channel feeds [`ResourceSnapshot`]s
+    /// from telemetry producers into a policy thread, which applies decisions
+    /// only after they persist past the hysteresis and cooldown thresholds.
+    pub struct Controller {
+        tx: SyncSender<ResourceSnapshot>,
+        dropped: AtomicU64,
+        handle: std::thread::JoinHandle<ControllerReport>,
+    }
+
+    impl Controller {
+        /// Start the policy thread over `graph`, which becomes the current
+        /// graph for `Repartition` decisions.
+        pub fn spawn<P>(graph: nc_nir::Graph, policy: P, cfg: ControllerConfig) -> Self
+        where
+            P: Policy + Send + 'static,
+        {
+            set_current_graph(graph);
+            let (tx, rx) = mpsc::sync_channel(cfg.channel_capacity.max(1));
+            let handle = std::thread::spawn(move || {
+                let mut report = ControllerReport::default();
+                let mut pending = Decision::NoChange;
+                let mut streak: u32 = 0;
+                let mut last_applied: Option<Instant> = None;
+                while let Ok(snapshot) = rx.recv() {
+                    report.snapshots_seen += 1;
+                    let decision = policy.decide(&snapshot);
+                    if decision == pending {
+                        streak += 1;
+                    } else {
+                        pending = decision;
+                        streak = 1;
+                    }
+                    if pending == Decision::NoChange || streak < cfg.hysteresis.max(1) {
+                        continue;
+                    }
+                    if last_applied.is_some_and(|t| t.elapsed() < cfg.cooldown) {
+                        continue;
+                    }
+                    if apply(&pending).is_ok() {
+                        if pending == Decision::Repartition {
+                            report.partition_parts = last_partition_plan().map(|p| p.parts);
+                        }
+                        report.applied.push(pending.clone());
+                        last_applied = Some(Instant::now());
+                        streak = 0;
+                    }
+                }
+                report
+            });
+            Self { tx, dropped: AtomicU64::new(0), handle }
+        }
+
+        /// Non-blocking hand-off from telemetry producers; a full queue drops
+        /// the snapshot rather than stalling the data path.
+        pub fn offer(&self, snapshot: ResourceSnapshot) -> bool {
+            match self.tx.try_send(snapshot) {
+                Ok(()) => true,
+                Err(TrySendError::Full(_)) | Err(TrySendError::Disconnected(_)) => {
+                    self.dropped.fetch_add(1, Ordering::Relaxed);
+                    false
+                }
+            }
+        }
+
+        /// Close the snapshot channel, let the policy thread drain what is
+        /// queued, and return its report.
+        pub fn stop(self) -> ControllerReport {
+            let dropped = self.dropped.load(Ordering::Relaxed);
+            drop(self.tx);
+            let mut report = self.handle.join().expect("policy thread panicked");
+            report.snapshots_dropped = dropped;
+            report
+        }
+    }
+
     #[cfg(test)]
     mod tests {
         use super::*;
@@ -250,5 +520,642 @@ pub mod adaptive {
             apply(&Decision::Reschedule).expect("reschedule ok");
             apply(&Decision::Throttle).expect("throttle ok");
         }
+
+        #[test]
+        fn idempotency_keys_age_out_of_the_bucket_window() {
+            let reg = IdemRegistry::new(Duration::from_millis(20));
+            assert!(!reg.register_if_new("k"), "first sighting is new");
+            assert!(reg.register_if_new("k"), "repeat inside the window dedupes");
+            std::thread::sleep(Duration::from_millis(60));
+            assert!(!reg.register_if_new("k"), "key expired with its bucket");
+        }
+
+        #[test]
+        fn controller_applies_repartition_after_hysteresis() {
+            let g = nc_nir::fixtures::chain(&[4, 4]);
+            let cfg = ControllerConfig {
+                channel_capacity: 16,
+                hysteresis: 2,
+                cooldown: Duration::ZERO,
+            };
+            let c = Controller::spawn(g, ThresholdPolicy::default(), cfg);
+            for _ in 0..5 {
+                assert!(c.offer(ResourceSnapshot::new(95.0, 10.0)));
+            }
+            let report = c.stop();
+            assert_eq!(report.snapshots_seen, 5);
+            assert!(report.applied.contains(&Decision::Repartition));
+            assert!(report.partition_parts.unwrap_or(0) > 0, "plan recorded");
+        }
+
+        #[test]
+        fn controller_hysteresis_suppresses_flapping() {
+            let g = nc_nir::fixtures::chain(&[4, 4]);
+            let cfg = ControllerConfig {
+                channel_capacity: 16,
+                hysteresis: 3,
+                cooldown: Duration::ZERO,
+            };
+            let c = Controller::spawn(g, ThresholdPolicy::default(), cfg);
+            // Alternate repartition/throttle pressure; no decision ever holds
+            // for three consecutive snapshots, so none should be applied.
+            for i in 0..8 {
+                let s = if i % 2 == 0 {
+                    ResourceSnapshot::new(95.0, 10.0)
+                } else {
+                    ResourceSnapshot::new(10.0, 95.0)
+                };
+                assert!(c.offer(s));
+            }
+            let report = c.stop();
+            assert_eq!(report.snapshots_seen, 8);
+            assert!(report.applied.is_empty(), "flapping decisions were held back");
+        }
+
+        #[test]
+        fn controller_offer_drops_when_queue_is_full() {
+            let g = nc_nir::fixtures::chain(&[4]);
+            let cfg = ControllerConfig {
+                channel_capacity: 1,
+                hysteresis: u32::MAX,
+                cooldown: Duration::ZERO,
+            };
+            let c = Controller::spawn(g, NoOpPolicy, cfg);
+            // Saturate the bounded queue faster than the policy thread can
+            // drain it; at least one offer must succeed and drops must be
+            // reported rather than blocking the producer.
+            let mut accepted = 0u64;
+            for _ in 0..256 {
+                if c.offer(ResourceSnapshot::new(1.0, 1.0)) {
+                    accepted += 1;
+                }
+            }
+            let report = c.stop();
+            assert!(accepted >= 1);
+            assert_eq!(report.snapshots_seen + report.snapshots_dropped, 256);
+        }
+    }
+}
+
+/// In-process reference simulator: SoA per-population state arrays, parallel
+/// population updates across a scoped thread pool, and delay-line spike
+/// queues honoring `Connection::delay_ms`. Dynamics mirror the generated
+/// backend runtimes (LIF decay 0.95, unit threshold default, source
+/// populations firing every `source_period` steps), so partitioner and
+/// quantizer changes can be behaviorally checked in CI without provisioning
+/// an external simulator.
+pub mod reference {
+    use super::*;
+    use std::thread;
+
+    #[cfg(feature = "telemetry")]
+    use std::collections::BTreeMap;
+
+    /// Per-step membrane decay factor, matching the emitted C kernels.
+    pub const LIF_DECAY: f32 = 0.95;
+    const DEFAULT_V_TH: f32 = 1.0;
+
+    #[derive(Debug, Clone)]
+    pub struct SimConfig {
+        /// Number of timesteps to run.
+        pub steps: u32,
+        /// Timestep width; `delay_ms` is quantized to whole steps of this.
+        pub dt_ms: f32,
+        /// Worker threads for the population update stage.
+        pub threads: usize,
+        /// Source populations fire their full size every this many steps.
+        pub source_period: u32,
+    }
+
+    impl Default for SimConfig {
+        fn default() -> Self {
+            Self {
+                steps: 100,
+                dt_ms: 1.0,
+                threads: thread::available_parallelism().map(|n| n.get()).unwrap_or(1),
+                source_period: 10,
+            }
+        }
+    }
+
+    #[derive(Debug, Clone)]
+    pub struct SimReport {
+        pub steps: u32,
+        /// Total spike events across all populations.
+        pub events: u64,
+        /// Per-population spike totals, in graph order.
+        pub spikes_per_population: Vec<(String, u64)>,
+        /// Step at which each population first spiked, in graph order.
+        pub first_spike_step: Vec<Option<u32>>,
+    }
+
+    pub fn run(g: &nc_nir::Graph, cfg: &SimConfig) -> Result<SimReport> {
+        anyhow::ensure!(cfg.dt_ms > 0.0, "dt_ms must be positive");
+        anyhow::ensure!(cfg.source_period > 0, "source_period must be positive");
+        let n_pops = g.populations.len();
+
+        // SoA state: one contiguous f32 plane per population, so update
+        // chunks hand disjoint &mut slices to the workers.
+        let mut v_m: Vec<Vec<f32>> = Vec::with_capacity(n_pops);
+        let mut in_cur: Vec<Vec<f32>> = Vec::with_capacity(n_pops);
+        let mut v_th: Vec<Vec<f32>> = Vec::with_capacity(n_pops);
+        let mut is_source: Vec<bool> = Vec::with_capacity(n_pops);
+        let mut index = std::collections::HashMap::with_capacity(n_pops);
+        for (i, p) in g.populations.iter().enumerate() {
+            let n = p.size as usize;
+            let th = p.params.get("v_th").and_then(|x| x.as_f64()).unwrap_or(DEFAULT_V_TH as f64) as f32;
+            v_m.push(vec![0.0; n]);
+            in_cur.push(vec![0.0; n]);
+            v_th.push(vec![th; n]);
+            is_source.push(p.model.eq_ignore_ascii_case("source"));
+            index.insert(p.name.as_str(), i);
+        }
+
+        // Connections resolved to indices with delays quantized to steps
+        // (minimum one step: a spike is never visible in the step it fires).
+        let conns: Vec<(usize, usize, f32, usize)> = g.connections.iter()
+            .filter_map(|c| {
+                let pre = *index.get(c.pre.as_str())?;
+                let post = *index.get(c.post.as_str())?;
+                let delay = ((c.delay_ms / cfg.dt_ms).ceil() as usize).max(1);
+                Some((pre, post, c.weight, delay))
+            })
+            .collect();
+        let ring_len = conns.iter().map(|&(_, _, _, d)| d).max().unwrap_or(1) + 1;
+        // Delay line: slot (step + delay) % ring_len collects (post, contribution)
+        // pairs due for delivery at that step.
+        let mut ring: Vec<Vec<(usize, f32)>> = vec![Vec::new(); ring_len];
+
+        #[cfg(feature = "telemetry")]
+        let app = std::env::var("NC_PROFILE_JSONL")
+            .ok()
+            .and_then(|p| telemetry::profiling::Appender::open(p).ok());
+        #[cfg(feature = "telemetry")]
+        let probe_targets: Vec<(usize, String)> = g.probes.iter()
+            .filter_map(|p| index.get(p.target.as_str()).map(|&i| (i, p.kind.clone())))
+            .collect();
+        #[cfg(feature = "telemetry")]
+        let base_labels = {
+            let mut l = BTreeMap::new();
+            l.insert("graph".to_string(), g.name.clone());
+            l.insert("simulator".to_string(), "reference".to_string());
+            l
+        };
+        #[cfg(feature = "telemetry")]
+        let _timer = app.as_ref().map(|a| a.start_timer("sim.run_ms", base_labels.clone()));
+
+        let threads = cfg.threads.max(1).min(n_pops.max(1));
+        let chunk = n_pops.div_ceil(threads).max(1);
+        let mut fired: Vec<u32> = vec![0; n_pops];
+        let mut spikes: Vec<u64> = vec![0; n_pops];
+        let mut first_spike: Vec<Option<u32>> = vec![None; n_pops];
+        let mut events: u64 = 0;
+
+        for step in 0..cfg.steps {
+            // Deliver contributions due this step.
+            let slot = step as usize % ring_len;
+            let due = std::mem::take(&mut ring[slot]);
+            for (post, contrib) in due {
+                for x in in_cur[post].iter_mut() {
+                    *x += contrib;
+                }
+            }
+
+            // Parallel update stage: decay + integrate + threshold per chunk.
+            let fire_source = step % cfg.source_period == 0;
+            thread::scope(|s| {
+                let iter = v_m.chunks_mut(chunk)
+                    .zip(in_cur.chunks_mut(chunk))
+                    .zip(v_th.chunks(chunk))
+                    .zip(is_source.chunks(chunk))
+                    .zip(fired.chunks_mut(chunk));
+                for ((((v_c, in_c), th_c), src_c), f_c) in iter {
+                    s.spawn(move || {
+                        for p in 0..v_c.len() {
+                            if src_c[p] {
+                                f_c[p] = if fire_source { v_c[p].len() as u32 } else { 0 };
+                                continue;
+                            }
+                            let mut f = 0u32;
+                            for j in 0..v_c[p].len() {
+                                let mut v = v_c[p][j] * LIF_DECAY + in_c[p][j];
+                                in_c[p][j] = 0.0;
+                                if v >= th_c[p][j] {
+                                    v = 0.0;
+                                    f += 1;
+                                }
+                                v_c[p][j] = v;
+                            }
+                            f_c[p] = f;
+                        }
+                    });
+                }
+            });
+
+            // Schedule spike deliveries into the delay line.
+            for &(pre, post, w, delay) in &conns {
+                let f = fired[pre];
+                if f > 0 {
+                    let at = (step as usize + delay) % ring_len;
+                    ring[at].push((post, w * f as f32));
+                }
+            }
+            for (p, &f) in fired.iter().enumerate() {
+                if f > 0 {
+                    spikes[p] += f as u64;
+                    events += f as u64;
+                    if first_spike[p].is_none() {
+                        first_spike[p] = Some(step);
+                    }
+                }
+            }
+
+            // Probe outputs, one record per probe per step.
+            #[cfg(feature = "telemetry")]
+            if let Some(a) = &app {
+                for (pi, kind) in &probe_targets {
+                    let mut labels = base_labels.clone();
+                    labels.insert("population".to_string(), g.populations[*pi].name.clone());
+                    labels.insert("step".to_string(), step.to_string());
+                    match kind.as_str() {
+                        "spikes" => {
+                            let _ = a.counter("sim.probe.spikes", fired[*pi] as f64, labels);
+                        }
+                        _ => {
+                            let n = v_m[*pi].len().max(1) as f64;
+                            let mean = v_m[*pi].iter().map(|&x| x as f64).sum::<f64>() / n;
+                            let _ = a.counter("sim.probe.v_mean", mean, labels);
+                        }
+                    }
+                }
+            }
+        }
+
+        #[cfg(feature = "telemetry")]
+        if let Some(a) = &app {
+            let _ = a.counter("sim.events", events as f64, base_labels.clone());
+            let _ = a.counter("sim.steps", cfg.steps as f64, base_labels);
+        }
+
+        Ok(SimReport {
+            steps: cfg.steps,
+            events,
+            spikes_per_population: g.populations.iter()
+                .map(|p| p.name.clone())
+                .zip(spikes)
+                .collect(),
+            first_spike_step: first_spike,
+        })
+    }
+
+    #[cfg(test)]
+    mod tests {
+        use super::*;
+
+        fn source_chain(weight: f32, delay_ms: f32) -> nc_nir::Graph {
+            let mut g = nc_nir::fixtures::chain(&[4, 8]);
+            g.populations[0].model = "source".to_string();
+            g.connections[0].weight = weight;
+            g.connections[0].delay_ms = delay_ms;
+            g
+        }
+
+        #[test]
+        fn source_drives_downstream_population() {
+            let g = source_chain(2.0, 1.0);
+            let r = run(&g, &SimConfig::default()).expect("run ok");
+            assert!(r.events > 0, "no events simulated");
+            assert!(r.spikes_per_population[1].1 > 0, "downstream population never fired");
+            // 4 source neurons * 2.0 crosses the unit threshold one step later
+            assert_eq!(r.first_spike_step[0], Some(0));
+            assert_eq!(r.first_spike_step[1], Some(1));
+        }
+
+        #[test]
+        fn delay_line_postpones_first_spike() {
+            let near = run(&source_chain(2.0, 1.0), &SimConfig::default()).unwrap();
+            let far = run(&source_chain(2.0, 5.0), &SimConfig::default()).unwrap();
+            assert_eq!(near.first_spike_step[1], Some(1));
+            assert_eq!(far.first_spike_step[1], Some(5));
+        }
+
+        #[test]
+        fn run_is_deterministic_across_thread_counts() {
+            let g = source_chain(0.4, 2.0);
+            let one = run(&g, &SimConfig { threads: 1, ..Default::default() }).unwrap();
+            let many = run(&g, &SimConfig { threads: 8, ..Default::default() }).unwrap();
+            assert_eq!(one.events, many.events);
+            assert_eq!(one.spikes_per_population, many.spikes_per_population);
+            assert_eq!(one.first_spike_step, many.first_spike_step);
+        }
+
+        #[test]
+        fn sub_threshold_weights_accumulate_before_firing() {
+            // 0.8 per source volley; with decay 0.95 the membrane needs two
+            // volleys to cross 1.0, so the first downstream spike comes later.
+            let g = source_chain(0.2, 1.0); // 4 sources -> 0.8 per volley
+            let r = run(&g, &SimConfig::default()).unwrap();
+            let first = r.first_spike_step[1].expect("eventually fires");
+            assert!(first > 1, "sub-threshold input should not fire immediately (got {first})");
+        }
+    }
+}
+
+/// Seekable zstd artifact container ("NCPK") for deploy payloads.
+///
+/// Every member is an independent zstd frame appended as it is produced, so
+/// packaging streams alongside compilation instead of re-reading the out-dir
+/// in a second pass, and extraction can seek straight to one member without
+/// decompressing its neighbors. A JSON index is embedded at the tail:
+///
+/// ```text
+/// [frame 0][frame 1]...[index JSON][index_off u64][index_len u64][b"NCPK"]
+/// ```
+pub mod package {
+    use anyhow::{bail, Context, Result};
+    use std::fs::File;
+    use std::io::{BufReader, BufWriter, Read, Seek, SeekFrom, Write};
+    use std::path::{Path, PathBuf};
+
+    pub const MAGIC: &[u8; 4] = b"NCPK";
+    const FOOTER_LEN: u64 = 8 + 8 + 4;
+    /// Default zstd level: fast enough to keep up with artifact production.
+    const LEVEL: i32 = 3;
+
+    #[derive(Debug, Clone, serde::Serialize, serde::Deserialize)]
+    pub struct MemberEntry {
+        /// Member path relative to the package root, '/'-separated.
+        pub path: String,
+        /// Byte offset of the member's zstd frame.
+        pub offset: u64,
+        pub compressed_len: u64,
+        /// Uncompressed size.
+        pub len: u64,
+    }
+
+    #[derive(Debug, serde::Serialize, serde::Deserialize)]
+    struct Index {
+        version: u32,
+        members: Vec<MemberEntry>,
+    }
+
+    struct CountingWriter<W: Write> {
+        inner: W,
+        written: u64,
+    }
+
+    impl<W: Write> Write for CountingWriter<W> {
+        fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+            let n = self.inner.write(buf)?;
+            self.written += n as u64;
+            Ok(n)
+        }
+        fn flush(&mut self) -> std::io::Result<()> {
+            self.inner.flush()
+        }
+    }
+
+    /// Streaming package writer: call [`PackageWriter::add_file`] as each
+    /// artifact lands, then [`PackageWriter::finish`] to seal the index.
+    pub struct PackageWriter {
+        out: BufWriter<File>,
+        members: Vec<MemberEntry>,
+        pos: u64,
+    }
+
+    impl PackageWriter {
+        pub fn create<P: AsRef<Path>>(path: P) -> Result<Self> {
+            let f = File::create(&path)
+                .with_context(|| format!("create package {:?}", path.as_ref()))?;
+            Ok(Self { out: BufWriter::new(f), members: Vec::new(), pos: 0 })
+        }
+
+        /// Compress one member from a reader; `name` is its path inside the
+        /// package.
+        pub fn add_reader<R: Read>(&mut self, name: &str, mut src: R) -> Result<()> {
+            let mut counter = CountingWriter { inner: &mut self.out, written: 0 };
+            let mut enc = zstd::stream::Encoder::new(&mut counter, LEVEL)?;
+            let len = std::io::copy(&mut src, &mut enc)?;
+            enc.finish()?;
+            let compressed_len = counter.written;
+            self.members.push(MemberEntry {
+                path: name.to_string(),
+                offset: self.pos,
+                compressed_len,
+                len,
+            });
+            self.pos += compressed_len;
+            Ok(())
+        }
+
+        pub fn add_bytes(&mut self, name: &str, bytes: &[u8]) -> Result<()> {
+            self.add_reader(name, bytes)
+        }
+
+        pub fn add_file<P: AsRef<Path>>(&mut self, name: &str, src: P) -> Result<()> {
+            let f = File::open(&src).with_context(|| format!("read member {:?}", src.as_ref()))?;
+            self.add_reader(name, BufReader::new(f))
+        }
+
+        /// Write the embedded index and footer; the package is unreadable
+        /// until this runs.
+        pub fn finish(mut self) -> Result<Vec<MemberEntry>> {
+            let index = Index { version: 1, members: std::mem::take(&mut self.members) };
+            let bytes = serde_json::to_vec(&index)?;
+            self.out.write_all(&bytes)?;
+            self.out.write_all(&self.pos.to_le_bytes())?;
+            self.out.write_all(&(bytes.len() as u64).to_le_bytes())?;
+            self.out.write_all(MAGIC)?;
+            self.out.flush()?;
+            Ok(index.members)
+        }
+    }
+
+    /// Random-access package reader over the embedded index.
+    pub struct PackageReader {
+        file: File,
+        members: Vec<MemberEntry>,
+    }
+
+    impl PackageReader {
+        pub fn open<P: AsRef<Path>>(path: P) -> Result<Self> {
+            let mut file = File::open(&path)
+                .with_context(|| format!("open package {:?}", path.as_ref()))?;
+            let total = file.seek(SeekFrom::End(0))?;
+            if total < FOOTER_LEN {
+                bail!("package too short for NCPK footer");
+            }
+            file.seek(SeekFrom::End(-(FOOTER_LEN as i64)))?;
+            let mut footer = [0u8; FOOTER_LEN as usize];
+            file.read_exact(&mut footer)?;
+            if &footer[16..20] != MAGIC {
+                bail!("bad package magic (not an NCPK container)");
+            }
+            let index_off = u64::from_le_bytes(footer[0..8].try_into().unwrap());
+            let index_len = u64::from_le_bytes(footer[8..16].try_into().unwrap());
+            if index_off + index_len + FOOTER_LEN != total {
+                bail!("corrupt NCPK index footer");
+            }
+            file.seek(SeekFrom::Start(index_off))?;
+            let mut bytes = vec![0u8; index_len as usize];
+            file.read_exact(&mut bytes)?;
+            let index: Index = serde_json::from_slice(&bytes).context("parse NCPK index")?;
+            Ok(Self { file, members: index.members })
+        }
+
+        pub fn members(&self) -> &[MemberEntry] {
+            &self.members
+        }
+
+        /// Decompress one member into `dst` by seeking to its frame.
+        pub fn read_member_to<W: Write>(&mut self, entry: &MemberEntry, dst: &mut W) -> Result<u64> {
+            self.file.seek(SeekFrom::Start(entry.offset))?;
+            let frame = (&self.file).take(entry.compressed_len);
+            let mut dec = zstd::stream::Decoder::new(frame)?;
+            let n = std::io::copy(&mut dec, dst)?;
+            if n != entry.len {
+                bail!("member '{}' decoded {} bytes, index says {}", entry.path, n, entry.len);
+            }
+            Ok(n)
+        }
+
+        /// Extract the members selected by `keep` under `dest`, creating
+        /// parent directories as needed; returns the extracted paths.
+        pub fn extract_matching<F>(&mut self, dest: &Path, keep: F) -> Result<Vec<PathBuf>>
+        where
+            F: Fn(&str) -> bool,
+        {
+            let selected: Vec<MemberEntry> =
+                self.members.iter().filter(|m| keep(&m.path)).cloned().collect();
+            let mut out = Vec::with_capacity(selected.len());
+            for m in &selected {
+                // Member paths are package-relative; refuse traversal.
+                if m.path.split('/').any(|c| c == "..") || m.path.starts_with('/') {
+                    bail!("refusing member path '{}'", m.path);
+                }
+                let target = dest.join(&m.path);
+                if let Some(parent) = target.parent() {
+                    std::fs::create_dir_all(parent)?;
+                }
+                let mut f = BufWriter::new(File::create(&target)?);
+                self.read_member_to(m, &mut f)?;
+                f.flush()?;
+                out.push(target);
+            }
+            Ok(out)
+        }
+    }
+
+    impl PackageWriter {
+        /// Recursively add a directory tree, rooting member paths at `dir`.
+        pub fn add_dir<P: AsRef<Path>>(&mut self, dir: P) -> Result<()> {
+            let dir = dir.as_ref();
+            let mut stack = vec![dir.to_path_buf()];
+            while let Some(d) = stack.pop() {
+                let mut entries: Vec<_> = std::fs::read_dir(&d)?.collect::<std::io::Result<_>>()?;
+                entries.sort_by_key(|e| e.file_name());
+                for e in entries {
+                    let p = e.path();
+                    if p.is_dir() {
+                        stack.push(p);
+                    } else {
+                        let rel = p
+                            .strip_prefix(dir)
+                            .expect("walk stays under root")
+                            .to_string_lossy()
+                            .replace('\\', "/");
+                        self.add_file(&rel, &p)?;
+                    }
+                }
+            }
+            Ok(())
+        }
+    }
+
+    /// Recursively package a directory tree, rooting member paths at `dir`.
+    pub fn pack_dir<P: AsRef<Path>, Q: AsRef<Path>>(dir: P, output: Q) -> Result<Vec<MemberEntry>> {
+        let mut w = PackageWriter::create(output)?;
+        w.add_dir(dir)?;
+        w.finish()
+    }
+
+    #[cfg(test)]
+    mod tests {
+        use super::*;
+
+        fn tmp(name: &str) -> PathBuf {
+            std::env::temp_dir().join(name)
+        }
+
+        #[test]
+        fn package_round_trips_members() {
+            let pkg = tmp("nc_pkg_roundtrip.ncpk");
+            let _ = std::fs::remove_file(&pkg);
+            let mut w = PackageWriter::create(&pkg).unwrap();
+            let big = vec![42u8; 1 << 18];
+            w.add_bytes("riscv64gcv_linux/main.c", b"int main(void){return 0;}\n").unwrap();
+            w.add_bytes("riscv64gcv_linux/kernel.bin", &big).unwrap();
+            w.add_bytes("PKG.txt", b"neuro-compiler package\n").unwrap();
+            let members = w.finish().unwrap();
+            assert_eq!(members.len(), 3);
+            // Compressible payload actually compressed.
+            assert!(members[1].compressed_len < members[1].len);
+
+            let mut r = PackageReader::open(&pkg).unwrap();
+            assert_eq!(r.members().len(), 3);
+            let entry = r.members().iter().find(|m| m.path.ends_with("kernel.bin")).cloned().unwrap();
+            let mut out = Vec::new();
+            r.read_member_to(&entry, &mut out).unwrap();
+            assert_eq!(out, big);
+            let _ = std::fs::remove_file(&pkg);
+        }
+
+        #[test]
+        fn extract_matching_unpacks_only_selected_members() {
+            let pkg = tmp("nc_pkg_selective.ncpk");
+            let dest = tmp("nc_pkg_selective_out");
+            let _ = std::fs::remove_file(&pkg);
+            let _ = std::fs::remove_dir_all(&dest);
+            let mut w = PackageWriter::create(&pkg).unwrap();
+            w.add_bytes("loihi2/core.cfg", b"cfg").unwrap();
+            w.add_bytes("riscv32imac_bare/main.c", b"c").unwrap();
+            w.add_bytes("PKG.txt", b"meta").unwrap();
+            w.finish().unwrap();
+
+            let mut r = PackageReader::open(&pkg).unwrap();
+            let got = r
+                .extract_matching(&dest, |p| p.starts_with("loihi2/") || !p.contains('/'))
+                .unwrap();
+            assert_eq!(got.len(), 2);
+            assert!(dest.join("loihi2/core.cfg").exists());
+            assert!(!dest.join("riscv32imac_bare").exists(), "unselected target skipped");
+            let _ = std::fs::remove_file(&pkg);
+            let _ = std::fs::remove_dir_all(&dest);
+        }
+
+        #[test]
+        fn pack_dir_streams_a_tree() {
+            let src = tmp("nc_pkg_tree_src");
+            let pkg = tmp("nc_pkg_tree.ncpk");
+            let _ = std::fs::remove_dir_all(&src);
+            let _ = std::fs::remove_file(&pkg);
+            std::fs::create_dir_all(src.join("passes")).unwrap();
+            std::fs::write(src.join("main.c"), "int main;").unwrap();
+            std::fs::write(src.join("passes/00_validate.json"), "{}").unwrap();
+            let members = pack_dir(&src, &pkg).unwrap();
+            let mut paths: Vec<&str> = members.iter().map(|m| m.path.as_str()).collect();
+            paths.sort_unstable();
+            assert_eq!(paths, vec!["main.c", "passes/00_validate.json"]);
+            let _ = std::fs::remove_dir_all(&src);
+            let _ = std::fs::remove_file(&pkg);
+        }
+
+        #[test]
+        fn reader_rejects_garbage() {
+            let pkg = tmp("nc_pkg_garbage.ncpk");
+            std::fs::write(&pkg, b"definitely not a package").unwrap();
+            assert!(PackageReader::open(&pkg).is_err());
+            let _ = std::fs::remove_file(&pkg);
+        }
     }
 }
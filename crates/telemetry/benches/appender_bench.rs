@@ -0,0 +1,35 @@
+use criterion::{criterion_group, criterion_main, Criterion, Throughput};
+use nc_telemetry::profiling::Appender;
+use std::collections::BTreeMap;
+
+fn bench_appender(c: &mut Criterion) {
+    let dir = std::env::temp_dir().join("nc_appender_bench");
+    std::fs::create_dir_all(&dir).expect("create bench dir");
+    let labels: BTreeMap<String, String> = BTreeMap::from([
+        ("graph".to_string(), "bench".to_string()),
+        ("pass".to_string(), "appender_bench".to_string()),
+    ]);
+
+    let mut group = c.benchmark_group("telemetry_appender");
+    group.throughput(Throughput::Elements(1));
+
+    let direct = Appender::open(dir.join("direct.jsonl")).expect("open direct appender");
+    group.bench_function("counter/direct", |b| {
+        b.iter(|| direct.counter("bench.metric", 1.0, labels.clone()).unwrap())
+    });
+
+    let buffered =
+        Appender::open_buffered(dir.join("buffered.jsonl"), 8192).expect("open buffered appender");
+    group.bench_function("counter/buffered", |b| {
+        b.iter(|| buffered.counter("bench.metric", 1.0, labels.clone()).unwrap())
+    });
+
+    group.finish();
+}
+
+criterion_group!(
+    name = appender_benches;
+    config = Criterion::default();
+    targets = bench_appender
+);
+criterion_main!(appender_benches);
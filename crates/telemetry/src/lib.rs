@@ -43,7 +43,7 @@ pub fn init_otel(_endpoint: Option<&str>) -> anyhow::Result<()> {
         let _ = std::panic::catch_unwind(|| {
             // register atexit hook
             ctrlc::set_handler(|| {
-                let _ = global::shutdown_tracer_provider();
+                global::shutdown_tracer_provider();
             }).ok();
         });
     }
@@ -58,7 +58,7 @@ pub mod profiling {
     use std::io::{BufRead, Write};
     use std::path::Path;
     use std::sync::{Arc, Mutex};
-    use std::time::{Instant, SystemTime, UNIX_EPOCH};
+    use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 
     /// JSONL Profile record schema (one record per line).
     /// Fields:
@@ -92,22 +92,121 @@ pub mod profiling {
             .as_millis() as u64
     }
 
+    /// Shared record sink behind an Appender and its TimerGuards.
+    /// Direct mode keeps the original lock-and-write-per-record behavior;
+    /// buffered mode hands pre-serialized lines to a background writer over a
+    /// bounded channel so the hot path never touches the file or its lock.
+    enum Sink {
+        Direct(Mutex<File>),
+        Buffered { tx: std::sync::mpsc::SyncSender<WriterMsg> },
+    }
+
+    enum WriterMsg {
+        Line(String),
+        Flush(std::sync::mpsc::SyncSender<()>),
+    }
+
+    impl Sink {
+        fn write_line(&self, line: String) -> Result<()> {
+            match self {
+                Sink::Direct(file) => {
+                    let mut guard = file.lock().expect("poisoned lock");
+                    writeln!(&mut *guard, "{line}")?;
+                    Ok(())
+                }
+                Sink::Buffered { tx } => {
+                    // Bounded send: producers back off instead of growing memory.
+                    tx.send(WriterMsg::Line(line))
+                        .map_err(|_| anyhow::anyhow!("telemetry writer thread is gone"))
+                }
+            }
+        }
+
+        fn flush(&self) -> Result<()> {
+            match self {
+                Sink::Direct(file) => {
+                    let mut guard = file.lock().expect("poisoned lock");
+                    guard.flush()?;
+                    Ok(())
+                }
+                Sink::Buffered { tx } => {
+                    let (ack_tx, ack_rx) = std::sync::mpsc::sync_channel(1);
+                    tx.send(WriterMsg::Flush(ack_tx))
+                        .map_err(|_| anyhow::anyhow!("telemetry writer thread is gone"))?;
+                    ack_rx.recv().map_err(|_| anyhow::anyhow!("telemetry writer thread is gone"))
+                }
+            }
+        }
+    }
+
     /// Appender writes ProfileRecord lines to a JSONL file and provides timer/counter helpers.
     pub struct Appender {
-        file: Arc<Mutex<File>>,
+        sink: Arc<Sink>,
     }
 
+    /// Default bound for the buffered appender's record queue.
+    pub const DEFAULT_BUFFER_CAPACITY: usize = 8192;
+
     impl Appender {
         pub fn open<P: AsRef<Path>>(path: P) -> Result<Self> {
             let f = File::create(path)?;
-            Ok(Self { file: Arc::new(Mutex::new(f)) })
+            Ok(Self { sink: Arc::new(Sink::Direct(Mutex::new(f))) })
+        }
+
+        /// Open in buffered mode: records go through a bounded queue drained
+        /// by one background writer that batches them into large buffered
+        /// writes. The JSONL schema is unchanged. Call [`Appender::flush`] to
+        /// force bytes to disk; dropping the appender drains and flushes.
+        pub fn open_buffered<P: AsRef<Path>>(path: P, capacity: usize) -> Result<Self> {
+            let f = File::create(path)?;
+            let (tx, rx) = std::sync::mpsc::sync_channel::<WriterMsg>(capacity.max(1));
+            std::thread::spawn(move || {
+                let mut out = std::io::BufWriter::with_capacity(1 << 20, f);
+                let write = |out: &mut std::io::BufWriter<File>, line: &str| {
+                    let _ = out.write_all(line.as_bytes());
+                    let _ = out.write_all(b"\n");
+                };
+                while let Ok(msg) = rx.recv() {
+                    match msg {
+                        WriterMsg::Line(line) => {
+                            write(&mut out, &line);
+                            // Drain whatever queued up behind us, then flush
+                            // once while the channel is idle.
+                            loop {
+                                match rx.try_recv() {
+                                    Ok(WriterMsg::Line(l)) => write(&mut out, &l),
+                                    Ok(WriterMsg::Flush(ack)) => {
+                                        let _ = out.flush();
+                                        let _ = ack.send(());
+                                    }
+                                    Err(_) => {
+                                        let _ = out.flush();
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                        WriterMsg::Flush(ack) => {
+                            let _ = out.flush();
+                            let _ = ack.send(());
+                        }
+                    }
+                }
+                // All senders gone: drain is implicit (recv returned Err only
+                // after the queue emptied), so just flush and exit.
+                let _ = out.flush();
+            });
+            Ok(Self { sink: Arc::new(Sink::Buffered { tx }) })
         }
 
         pub fn log(&self, rec: &ProfileRecord) -> Result<()> {
             let line = serde_json::to_string(rec)?;
-            let mut guard = self.file.lock().expect("poisoned lock");
-            writeln!(&mut *guard, "{line}")?;
-            Ok(())
+            self.sink.write_line(line)
+        }
+
+        /// Force queued records onto disk. A no-op barrier in direct mode.
+        pub fn flush(&self) -> Result<()> {
+            self.sink.flush()
         }
 
         pub fn start_timer(&self, metric: impl Into<String>, labels: BTreeMap<String, String>) -> TimerGuard {
@@ -115,7 +214,7 @@ pub mod profiling {
                 start: Instant::now(),
                 metric: metric.into(),
                 labels,
-                file: self.file.clone(),
+                sink: self.sink.clone(),
             }
         }
 
@@ -130,12 +229,44 @@ pub mod profiling {
         }
     }
 
+    impl Clone for Appender {
+        fn clone(&self) -> Self {
+            // Clones share one sink, so concurrent holders append to the same
+            // file instead of re-opening (and truncating) it.
+            Self { sink: self.sink.clone() }
+        }
+    }
+
+    impl Drop for Appender {
+        fn drop(&mut self) {
+            // Drain-on-drop for buffered mode: everything logged before this
+            // point is on disk when drop returns. Outstanding TimerGuards keep
+            // the writer alive through their own Arc<Sink>.
+            let _ = self.sink.flush();
+        }
+    }
+
+    /// Process-wide appender for the path in `NC_PROFILE_JSONL`, opened once
+    /// on first use. `Appender::open` truncates, so call sites that may run
+    /// concurrently against the same file (e.g. backend fan-out) must share
+    /// this instead of opening their own.
+    pub fn env_appender() -> Option<Appender> {
+        static SHARED: std::sync::OnceLock<Option<Appender>> = std::sync::OnceLock::new();
+        SHARED
+            .get_or_init(|| {
+                std::env::var("NC_PROFILE_JSONL")
+                    .ok()
+                    .and_then(|p| Appender::open(p).ok())
+            })
+            .clone()
+    }
+
     /// A guard that records elapsed time to the JSONL on drop.
     pub struct TimerGuard {
         start: Instant,
         metric: String,
         labels: BTreeMap<String, String>,
-        file: Arc<Mutex<File>>,
+        sink: Arc<Sink>,
     }
 
     impl Drop for TimerGuard {
@@ -147,12 +278,439 @@ pub mod profiling {
                 value: elapsed_ms,
                 labels: std::mem::take(&mut self.labels),
             };
-            if let Ok(mut guard) = self.file.lock() {
-                let _ = writeln!(&mut *guard, "{}", serde_json::to_string(&rec).unwrap_or_default());
+            if let Ok(line) = serde_json::to_string(&rec) {
+                let _ = self.sink.write_line(line);
             }
         }
     }
 
+    /// Mergeable logarithmic-bucket quantile sketch (~2% relative error).
+    ///
+    /// Positive values land in bucket `ceil(ln(v) / ln(GAMMA))`; zero and
+    /// negative values (rare for our metrics) are counted separately and
+    /// reported as 0.0. Sketches built over disjoint chunks of a stream merge
+    /// by summing buckets, which is what lets [`summarize_quantiles_jsonl`]
+    /// process a file in parallel.
+    #[derive(Debug, Clone)]
+    pub struct QuantileSketch {
+        count: u64,
+        sum: f64,
+        min: f64,
+        max: f64,
+        zero_or_neg: u64,
+        buckets: std::collections::HashMap<i32, u64>,
+    }
+
+    const SKETCH_GAMMA: f64 = 1.02;
+
+    // An empty sketch needs min/max at the infinities so the first recorded
+    // value wins; a derived Default would zero them.
+    impl Default for QuantileSketch {
+        fn default() -> Self {
+            Self::new()
+        }
+    }
+
+    impl QuantileSketch {
+        pub fn new() -> Self {
+            Self {
+                count: 0,
+                sum: 0.0,
+                min: f64::INFINITY,
+                max: f64::NEG_INFINITY,
+                zero_or_neg: 0,
+                buckets: std::collections::HashMap::new(),
+            }
+        }
+
+        pub fn record(&mut self, v: f64) {
+            if !v.is_finite() {
+                return;
+            }
+            self.count += 1;
+            self.sum += v;
+            if v < self.min { self.min = v; }
+            if v > self.max { self.max = v; }
+            if v <= 0.0 {
+                self.zero_or_neg += 1;
+            } else {
+                let idx = (v.ln() / SKETCH_GAMMA.ln()).ceil() as i32;
+                *self.buckets.entry(idx).or_insert(0) += 1;
+            }
+        }
+
+        pub fn merge(&mut self, other: &QuantileSketch) {
+            self.count += other.count;
+            self.sum += other.sum;
+            if other.min < self.min { self.min = other.min; }
+            if other.max > self.max { self.max = other.max; }
+            self.zero_or_neg += other.zero_or_neg;
+            for (k, c) in &other.buckets {
+                *self.buckets.entry(*k).or_insert(0) += c;
+            }
+        }
+
+        pub fn count(&self) -> u64 { self.count }
+        pub fn sum(&self) -> f64 { self.sum }
+        pub fn min(&self) -> f64 { self.min }
+        pub fn max(&self) -> f64 { self.max }
+
+        /// Approximate value at quantile `q` in [0,1].
+        pub fn quantile(&self, q: f64) -> f64 {
+            if self.count == 0 {
+                return 0.0;
+            }
+            let rank = ((q.clamp(0.0, 1.0)) * self.count as f64).ceil().max(1.0) as u64;
+            let mut cum = self.zero_or_neg;
+            if cum >= rank {
+                return 0.0;
+            }
+            let mut keys: Vec<i32> = self.buckets.keys().copied().collect();
+            keys.sort_unstable();
+            for k in keys {
+                cum += self.buckets[&k];
+                if cum >= rank {
+                    // Midpoint of the bucket (gamma^(k-1), gamma^k].
+                    let est = 2.0 * SKETCH_GAMMA.powi(k) / (SKETCH_GAMMA + 1.0);
+                    return est.clamp(self.min, self.max);
+                }
+            }
+            self.max
+        }
+    }
+
+    /// Build a per-metric quantile sketch from a profile JSONL file,
+    /// processing the file in parallel byte-range chunks. Each chunk starts
+    /// at the first full line past its offset; per-chunk sketches are merged
+    /// at the end, so the result is independent of the chunking.
+    pub fn summarize_quantiles_jsonl<P: AsRef<Path>>(
+        path: P,
+    ) -> Result<std::collections::HashMap<String, QuantileSketch>> {
+        use std::io::{BufRead, BufReader, Seek, SeekFrom};
+
+        let path = path.as_ref();
+        let file_len = std::fs::metadata(path)?.len();
+        let threads = std::thread::available_parallelism().map(|n| n.get()).unwrap_or(1).min(8);
+        // Small files do not amortize the extra opens.
+        let threads = if file_len < 4 * 1024 * 1024 { 1 } else { threads };
+        let chunk = file_len / threads as u64 + 1;
+
+        let scan_range = |start: u64, end: u64| -> Result<std::collections::HashMap<String, QuantileSketch>> {
+            let mut sketches: std::collections::HashMap<String, QuantileSketch> = std::collections::HashMap::new();
+            let f = std::fs::File::open(path)?;
+            let mut rdr = BufReader::new(f);
+            let mut pos = start;
+            rdr.seek(SeekFrom::Start(start))?;
+            let mut line = String::new();
+            if start > 0 {
+                // Skip the partial line owned by the previous chunk.
+                pos += rdr.read_line(&mut line)? as u64;
+                line.clear();
+            }
+            while pos < end {
+                let n = rdr.read_line(&mut line)?;
+                if n == 0 {
+                    break;
+                }
+                pos += n as u64;
+                let l = line.trim();
+                if !l.is_empty() {
+                    if let Ok(rec) = serde_json::from_str::<ProfileRecord>(l) {
+                        sketches.entry(rec.metric).or_default().record(rec.value);
+                    }
+                }
+                line.clear();
+            }
+            Ok(sketches)
+        };
+
+        let mut merged: std::collections::HashMap<String, QuantileSketch> = std::collections::HashMap::new();
+        let partials: Vec<Result<std::collections::HashMap<String, QuantileSketch>>> =
+            std::thread::scope(|s| {
+                let handles: Vec<_> = (0..threads)
+                    .map(|i| {
+                        let start = i as u64 * chunk;
+                        let end = (start + chunk).min(file_len);
+                        let scan = &scan_range;
+                        s.spawn(move || scan(start, end))
+                    })
+                    .collect();
+                handles.into_iter().map(|h| h.join().expect("summarizer thread panicked")).collect()
+            });
+        for part in partials {
+            for (metric, sketch) in part? {
+                merged.entry(metric).or_default().merge(&sketch);
+            }
+        }
+        Ok(merged)
+    }
+
+    /// One aggregated series: a metric name plus its label set.
+    pub type SeriesKey = (String, BTreeMap<String, String>);
+
+    /// Statistic suffixes an [`AggregatingRecorder`] emits per series each
+    /// flush, in emission order.
+    pub const SUMMARY_SUFFIXES: [&str; 7] = ["count", "sum", "min", "max", "p50", "p95", "p99"];
+
+    /// Shared state between an [`AggregatingRecorder`] and its flusher thread.
+    struct AggState {
+        /// Sketches sharded by recording thread so hot paths take an
+        /// uncontended lock; the flusher drains and merges across shards.
+        shards: Vec<Mutex<std::collections::HashMap<SeriesKey, QuantileSketch>>>,
+        appender: Appender,
+    }
+
+    impl AggState {
+        fn shard_for_current_thread(&self) -> &Mutex<std::collections::HashMap<SeriesKey, QuantileSketch>> {
+            use std::hash::{Hash, Hasher};
+            let mut h = std::collections::hash_map::DefaultHasher::new();
+            std::thread::current().id().hash(&mut h);
+            &self.shards[(h.finish() as usize) % self.shards.len()]
+        }
+
+        fn record(&self, metric: &str, value: f64, labels: BTreeMap<String, String>) {
+            let mut map = self.shard_for_current_thread().lock().expect("aggregation shard poisoned");
+            map.entry((metric.to_string(), labels))
+                .or_default()
+                .record(value);
+        }
+
+        /// Drain every shard, merge per series, and emit one summary family
+        /// (`<metric>.count/.sum/.min/.max/.p50/.p95/.p99`) per series. Each
+        /// summary is a plain [`ProfileRecord`], so `summarize_jsonl` and
+        /// other JSONL consumers read the output unchanged.
+        fn flush_summaries(&self) -> Result<()> {
+            let mut merged: std::collections::HashMap<SeriesKey, QuantileSketch> = std::collections::HashMap::new();
+            for shard in &self.shards {
+                let taken = std::mem::take(&mut *shard.lock().expect("aggregation shard poisoned"));
+                for (k, s) in taken {
+                    merged.entry(k).or_default().merge(&s);
+                }
+            }
+            let ts_ms = now_ms();
+            for ((metric, labels), s) in merged {
+                if s.count() == 0 {
+                    continue;
+                }
+                let stats = [
+                    s.count() as f64,
+                    s.sum(),
+                    s.min(),
+                    s.max(),
+                    s.quantile(0.50),
+                    s.quantile(0.95),
+                    s.quantile(0.99),
+                ];
+                for (suffix, value) in SUMMARY_SUFFIXES.iter().zip(stats) {
+                    self.appender.log(&ProfileRecord {
+                        ts_ms,
+                        metric: format!("{metric}.{suffix}"),
+                        value,
+                        labels: labels.clone(),
+                    })?;
+                }
+            }
+            self.appender.flush()
+        }
+    }
+
+    /// Aggregating profiling mode: samples accumulate into per-thread-shard
+    /// [`QuantileSketch`]es keyed by (metric, labels), and a background
+    /// flusher emits one summary record family per series per interval.
+    /// Recording a sample is a shard lock plus a bucket increment — no serde,
+    /// no I/O — so it is safe to call from per-timestep inner loops where a
+    /// [`TimerGuard`] per iteration would dominate the work being measured.
+    pub struct AggregatingRecorder {
+        state: Arc<AggState>,
+        stop_tx: Option<std::sync::mpsc::Sender<()>>,
+        flusher: Option<std::thread::JoinHandle<()>>,
+    }
+
+    impl AggregatingRecorder {
+        /// Wrap `appender` and emit summaries every `interval`. A final
+        /// summary is flushed when the recorder is dropped.
+        pub fn new(appender: Appender, interval: Duration) -> Self {
+            let shards = std::thread::available_parallelism()
+                .map(|n| n.get() * 2)
+                .unwrap_or(8)
+                .max(1);
+            let state = Arc::new(AggState {
+                shards: (0..shards).map(|_| Mutex::new(std::collections::HashMap::new())).collect(),
+                appender,
+            });
+            let (stop_tx, stop_rx) = std::sync::mpsc::channel::<()>();
+            let flusher_state = state.clone();
+            let flusher = std::thread::spawn(move || {
+                // recv_timeout doubles as the interval tick and the stop
+                // signal; the owning recorder flushes once more after join.
+                while let Err(std::sync::mpsc::RecvTimeoutError::Timeout) =
+                    stop_rx.recv_timeout(interval.max(Duration::from_millis(1)))
+                {
+                    let _ = flusher_state.flush_summaries();
+                }
+            });
+            Self { state, stop_tx: Some(stop_tx), flusher: Some(flusher) }
+        }
+
+        /// Open a JSONL file and aggregate into it; see [`AggregatingRecorder::new`].
+        pub fn open<P: AsRef<Path>>(path: P, interval: Duration) -> Result<Self> {
+            Ok(Self::new(Appender::open(path)?, interval))
+        }
+
+        /// Fold one sample into the current interval's sketch for (metric, labels).
+        pub fn record(&self, metric: &str, value: f64, labels: BTreeMap<String, String>) {
+            self.state.record(metric, value, labels);
+        }
+
+        /// Time a scope; elapsed milliseconds fold into the sketch on drop.
+        pub fn start_timer(&self, metric: impl Into<String>, labels: BTreeMap<String, String>) -> AggTimerGuard<'_> {
+            AggTimerGuard { start: Instant::now(), metric: metric.into(), labels, recorder: self }
+        }
+
+        /// Force an immediate summary emission for everything recorded so far.
+        pub fn flush(&self) -> Result<()> {
+            self.state.flush_summaries()
+        }
+    }
+
+    impl Drop for AggregatingRecorder {
+        fn drop(&mut self) {
+            if let Some(tx) = self.stop_tx.take() {
+                drop(tx);
+            }
+            if let Some(h) = self.flusher.take() {
+                let _ = h.join();
+            }
+            let _ = self.state.flush_summaries();
+        }
+    }
+
+    /// Like [`TimerGuard`] but folds into an aggregation sketch instead of
+    /// serializing a record per sample.
+    pub struct AggTimerGuard<'a> {
+        start: Instant,
+        metric: String,
+        labels: BTreeMap<String, String>,
+        recorder: &'a AggregatingRecorder,
+    }
+
+    impl Drop for AggTimerGuard<'_> {
+        fn drop(&mut self) {
+            let elapsed_ms = self.start.elapsed().as_secs_f64() * 1000.0;
+            self.recorder.record(&self.metric, elapsed_ms, std::mem::take(&mut self.labels));
+        }
+    }
+
+    /// Summary stats keyed by the stable join key for baseline comparisons:
+    /// metric name plus the full label set (see [`crate::labels`]).
+    pub fn summarize_jsonl_by_series<P: AsRef<Path>>(
+        path: P,
+    ) -> Result<std::collections::HashMap<SeriesKey, (usize, f64, f64, f64)>> {
+        let f = std::fs::File::open(path)?;
+        let rdr = std::io::BufReader::new(f);
+        let mut stats: std::collections::HashMap<SeriesKey, (usize, f64, f64, f64)> =
+            std::collections::HashMap::new();
+        for l in rdr.lines().map_while(Result::ok) {
+            if l.trim().is_empty() {
+                continue;
+            }
+            if let Ok(rec) = serde_json::from_str::<ProfileRecord>(&l) {
+                let e = stats
+                    .entry((rec.metric, rec.labels))
+                    .or_insert((0, 0.0, f64::INFINITY, f64::NEG_INFINITY));
+                e.0 += 1;
+                e.1 += rec.value;
+                if rec.value < e.2 { e.2 = rec.value; }
+                if rec.value > e.3 { e.3 = rec.value; }
+            }
+        }
+        Ok(stats)
+    }
+
+    /// One joined series from [`diff_summaries`]. All timing and count
+    /// metrics in this workspace are lower-is-better, so only increases can
+    /// breach a budget.
+    #[derive(Debug, Clone)]
+    pub struct MetricDelta {
+        pub metric: String,
+        pub labels: BTreeMap<String, String>,
+        pub baseline_avg: f64,
+        pub current_avg: f64,
+        /// Percent change of the mean vs baseline; infinite when a series
+        /// appears from a zero baseline.
+        pub delta_pct: f64,
+        /// Budget applied to this series, if any.
+        pub budget_pct: Option<f64>,
+        pub breached: bool,
+    }
+
+    /// Join two per-series summaries on (metric, labels) and evaluate
+    /// percentage regression budgets. `budgets` maps metric names to the
+    /// largest tolerated increase in percent; `default_budget_pct` covers
+    /// metrics without an explicit entry (None = unbudgeted, report-only).
+    /// Series present on only one side are reported with the missing mean
+    /// as NaN and never breach.
+    pub fn diff_summaries(
+        baseline: &std::collections::HashMap<SeriesKey, (usize, f64, f64, f64)>,
+        current: &std::collections::HashMap<SeriesKey, (usize, f64, f64, f64)>,
+        budgets: &std::collections::HashMap<String, f64>,
+        default_budget_pct: Option<f64>,
+    ) -> Vec<MetricDelta> {
+        let avg = |s: &(usize, f64, f64, f64)| if s.0 > 0 { s.1 / s.0 as f64 } else { 0.0 };
+        let mut out = Vec::new();
+        for (key, base) in baseline {
+            let (metric, labels) = key;
+            let budget_pct = budgets.get(metric).copied().or(default_budget_pct);
+            let b = avg(base);
+            match current.get(key) {
+                Some(cur) => {
+                    let c = avg(cur);
+                    let delta_pct = if b == 0.0 {
+                        if c == 0.0 { 0.0 } else { f64::INFINITY }
+                    } else {
+                        (c - b) / b * 100.0
+                    };
+                    let breached = budget_pct.is_some_and(|limit| delta_pct > limit);
+                    out.push(MetricDelta {
+                        metric: metric.clone(),
+                        labels: labels.clone(),
+                        baseline_avg: b,
+                        current_avg: c,
+                        delta_pct,
+                        budget_pct,
+                        breached,
+                    });
+                }
+                None => out.push(MetricDelta {
+                    metric: metric.clone(),
+                    labels: labels.clone(),
+                    baseline_avg: b,
+                    current_avg: f64::NAN,
+                    delta_pct: f64::NAN,
+                    budget_pct,
+                    breached: false,
+                }),
+            }
+        }
+        for (key, cur) in current {
+            if baseline.contains_key(key) {
+                continue;
+            }
+            let (metric, labels) = key;
+            out.push(MetricDelta {
+                metric: metric.clone(),
+                labels: labels.clone(),
+                baseline_avg: f64::NAN,
+                current_avg: avg(cur),
+                delta_pct: f64::NAN,
+                budget_pct: budgets.get(metric).copied().or(default_budget_pct),
+                breached: false,
+            });
+        }
+        out.sort_by(|a, b| a.metric.cmp(&b.metric).then_with(|| a.labels.cmp(&b.labels)));
+        out
+    }
+
     /// Summarize a JSONL file of ProfileRecord objects into (count,sum,min,max) per metric.
     pub fn summarize_jsonl<P: AsRef<Path>>(path: P) -> Result<std::collections::HashMap<String, (usize, f64, f64, f64)>> {
         let f = std::fs::File::open(path)?;
@@ -247,7 +805,7 @@ pub mod labels {
 
 #[cfg(test)]
 mod tests_profile {
-    use super::profiling::{emit_profile_jsonl, ProfileRecord};
+    use super::profiling::{emit_profile_jsonl, Appender, ProfileRecord};
     use std::collections::BTreeMap;
     use std::time::{SystemTime, UNIX_EPOCH};
 
@@ -267,4 +825,206 @@ mod tests_profile {
         let data = std::fs::read_to_string(&path).expect("read jsonl");
         assert!(data.lines().count() >= 2, "expected at least 2 JSONL records");
     }
+
+    #[test]
+    fn quantile_sketch_tracks_percentiles() {
+        use super::profiling::QuantileSketch;
+        let mut s = QuantileSketch::new();
+        for v in 1..=1000 {
+            s.record(v as f64);
+        }
+        assert_eq!(s.count(), 1000);
+        // Log-bucket sketch guarantees ~2% relative error.
+        let p50 = s.quantile(0.50);
+        let p95 = s.quantile(0.95);
+        let p99 = s.quantile(0.99);
+        assert!((p50 - 500.0).abs() / 500.0 < 0.03, "p50={p50}");
+        assert!((p95 - 950.0).abs() / 950.0 < 0.03, "p95={p95}");
+        assert!((p99 - 990.0).abs() / 990.0 < 0.03, "p99={p99}");
+        // Merging two halves matches a single sketch over the union.
+        let mut a = QuantileSketch::new();
+        let mut b = QuantileSketch::new();
+        for v in 1..=500 { a.record(v as f64); }
+        for v in 501..=1000 { b.record(v as f64); }
+        a.merge(&b);
+        assert_eq!(a.count(), 1000);
+        assert!((a.quantile(0.95) - p95).abs() < 1e-9);
+    }
+
+    #[test]
+    fn summarize_quantiles_reads_jsonl() {
+        use super::profiling::summarize_quantiles_jsonl;
+        let ts = SystemTime::now().duration_since(UNIX_EPOCH).unwrap().as_millis() as u64;
+        let recs: Vec<ProfileRecord> = (1..=200)
+            .map(|i| ProfileRecord {
+                ts_ms: ts,
+                metric: "kernel.step_ns".into(),
+                value: i as f64 * 10.0,
+                labels: BTreeMap::new(),
+            })
+            .collect();
+        let mut path = std::env::temp_dir();
+        path.push("nc_profile_quantiles_test.jsonl");
+        let _ = std::fs::remove_file(&path);
+        emit_profile_jsonl(&path, &recs).expect("emit");
+        let sketches = summarize_quantiles_jsonl(&path).expect("summarize");
+        let s = sketches.get("kernel.step_ns").expect("metric present");
+        assert_eq!(s.count(), 200);
+        assert!((s.min() - 10.0).abs() < 1e-9);
+        assert!((s.max() - 2000.0).abs() < 1e-9);
+        let p50 = s.quantile(0.5);
+        assert!((p50 - 1000.0).abs() / 1000.0 < 0.03, "p50={p50}");
+    }
+
+    #[test]
+    fn buffered_appender_drains_all_records() {
+        let mut path = std::env::temp_dir();
+        path.push("nc_profile_buffered_test.jsonl");
+        let _ = std::fs::remove_file(&path);
+        let app = Appender::open_buffered(&path, 64).expect("open buffered");
+        let n = 500;
+        for i in 0..n {
+            let labels = BTreeMap::new();
+            app.counter("buffered.count", i as f64, labels).expect("log");
+        }
+        {
+            let _t = app.start_timer("buffered.timer_ms", BTreeMap::new());
+        }
+        app.flush().expect("flush");
+        let data = std::fs::read_to_string(&path).expect("read jsonl");
+        assert_eq!(data.lines().count(), n + 1, "all queued records plus timer present");
+        // Schema unchanged: every line parses as a ProfileRecord.
+        for l in data.lines() {
+            let _: ProfileRecord = serde_json::from_str(l).expect("valid record");
+        }
+    }
+
+    #[test]
+    fn diff_summaries_joins_on_metric_and_labels_and_applies_budgets() {
+        use super::profiling::{diff_summaries, SeriesKey};
+        use std::collections::HashMap;
+        let series = |metric: &str, target: &str| -> SeriesKey {
+            (metric.to_string(), super::labels::target(target))
+        };
+        // (count, sum, min, max): avg is what the comparator judges.
+        let mut base: HashMap<SeriesKey, (usize, f64, f64, f64)> = HashMap::new();
+        base.insert(series("kernel.step_ns", "loihi2"), (10, 1000.0, 90.0, 110.0));
+        base.insert(series("kernel.step_ns", "riscv64gcv_linux"), (10, 1000.0, 90.0, 110.0));
+        base.insert(series("backend.compile_ms", "loihi2"), (2, 20.0, 9.0, 11.0));
+        let mut cur = base.clone();
+        // Same metric regresses on one target only; the label join keeps the
+        // healthy target's series separate.
+        cur.insert(series("kernel.step_ns", "loihi2"), (10, 1200.0, 100.0, 130.0));
+        cur.remove(&series("backend.compile_ms", "loihi2"));
+        cur.insert(series("sim.run_ms", "loihi2"), (1, 5.0, 5.0, 5.0));
+
+        let mut budgets = HashMap::new();
+        budgets.insert("kernel.step_ns".to_string(), 5.0);
+        let deltas = diff_summaries(&base, &cur, &budgets, None);
+        assert_eq!(deltas.len(), 4);
+        let hot = deltas.iter().find(|d| d.metric == "kernel.step_ns" && d.labels["target"] == "loihi2").unwrap();
+        assert!(hot.breached, "20% over a 5% budget breaches");
+        assert!((hot.delta_pct - 20.0).abs() < 1e-9);
+        let ok = deltas.iter().find(|d| d.metric == "kernel.step_ns" && d.labels["target"] == "riscv64gcv_linux").unwrap();
+        assert!(!ok.breached);
+        let gone = deltas.iter().find(|d| d.metric == "backend.compile_ms").unwrap();
+        assert!(gone.current_avg.is_nan() && !gone.breached);
+        let new = deltas.iter().find(|d| d.metric == "sim.run_ms").unwrap();
+        assert!(new.baseline_avg.is_nan() && !new.breached);
+        // An unbudgeted regression only breaches once a default budget applies.
+        let strict = diff_summaries(&base, &cur, &HashMap::new(), Some(10.0));
+        let hot = strict.iter().find(|d| d.metric == "kernel.step_ns" && d.labels["target"] == "loihi2").unwrap();
+        assert!(hot.breached);
+    }
+
+    #[test]
+    fn aggregating_recorder_emits_one_summary_family() {
+        use super::profiling::{summarize_jsonl, AggregatingRecorder, SUMMARY_SUFFIXES};
+        use std::time::Duration;
+        let mut path = std::env::temp_dir();
+        path.push("nc_profile_agg_test.jsonl");
+        let _ = std::fs::remove_file(&path);
+        {
+            // Interval far beyond the test: only the drop flush emits.
+            let rec = AggregatingRecorder::open(&path, Duration::from_secs(3600)).expect("open");
+            let labels = super::labels::graph("g1");
+            for i in 1..=1000 {
+                rec.record("kernel.step_ns", i as f64, labels.clone());
+            }
+            {
+                let _t = rec.start_timer("agg.timer_ms", BTreeMap::new());
+            }
+        }
+        let data = std::fs::read_to_string(&path).expect("read jsonl");
+        // Two series, one summary family each — not 1001 sample records.
+        assert_eq!(data.lines().count(), 2 * SUMMARY_SUFFIXES.len());
+        let stats = summarize_jsonl(&path).expect("summaries stay consumable");
+        let (n, sum, _, _) = stats["kernel.step_ns.count"];
+        assert_eq!(n, 1);
+        assert!((sum - 1000.0).abs() < 1e-9);
+        let (_, p50, _, _) = stats["kernel.step_ns.p50"];
+        assert!((p50 - 500.0).abs() / 500.0 < 0.03, "p50={p50}");
+        // Labels survive aggregation.
+        let line = data.lines().find(|l| l.contains("kernel.step_ns.count")).expect("count line");
+        let r: ProfileRecord = serde_json::from_str(line).expect("valid record");
+        assert_eq!(r.labels.get("graph").map(String::as_str), Some("g1"));
+    }
+
+    #[test]
+    fn aggregating_recorder_merges_across_threads() {
+        use super::profiling::{summarize_jsonl, AggregatingRecorder};
+        use std::time::Duration;
+        let mut path = std::env::temp_dir();
+        path.push("nc_profile_agg_threads_test.jsonl");
+        let _ = std::fs::remove_file(&path);
+        {
+            let rec = AggregatingRecorder::open(&path, Duration::from_secs(3600)).expect("open");
+            std::thread::scope(|s| {
+                for _ in 0..4 {
+                    s.spawn(|| {
+                        for _ in 0..250 {
+                            rec.record("agg.threads", 1.0, BTreeMap::new());
+                        }
+                    });
+                }
+            });
+        }
+        let stats = summarize_jsonl(&path).expect("summarize");
+        let (_, count_sum, _, _) = stats["agg.threads.count"];
+        assert!((count_sum - 1000.0).abs() < 1e-9, "all shards merged: {count_sum}");
+    }
+
+    #[test]
+    fn aggregating_recorder_interval_flusher_runs() {
+        use super::profiling::AggregatingRecorder;
+        use std::time::Duration;
+        let mut path = std::env::temp_dir();
+        path.push("nc_profile_agg_interval_test.jsonl");
+        let _ = std::fs::remove_file(&path);
+        let rec = AggregatingRecorder::open(&path, Duration::from_millis(20)).expect("open");
+        rec.record("agg.interval", 42.0, BTreeMap::new());
+        let deadline = std::time::Instant::now() + Duration::from_secs(5);
+        loop {
+            let len = std::fs::metadata(&path).map(|m| m.len()).unwrap_or(0);
+            if len > 0 {
+                break;
+            }
+            assert!(std::time::Instant::now() < deadline, "flusher never emitted");
+            std::thread::sleep(Duration::from_millis(10));
+        }
+        drop(rec);
+    }
+
+    #[test]
+    fn buffered_appender_flushes_on_drop() {
+        let mut path = std::env::temp_dir();
+        path.push("nc_profile_buffered_drop_test.jsonl");
+        let _ = std::fs::remove_file(&path);
+        {
+            let app = Appender::open_buffered(&path, 16).expect("open buffered");
+            app.counter("dropped.count", 1.0, BTreeMap::new()).expect("log");
+        }
+        let data = std::fs::read_to_string(&path).expect("read jsonl");
+        assert_eq!(data.lines().count(), 1);
+    }
 }